@@ -6,12 +6,15 @@
 #include "brave/browser/brave_browser_main_parts.h"
 
 #include "base/command_line.h"
+#include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/browsing_data/brave_clear_browsing_data.h"
 #include "brave/common/brave_constants.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_sync/buildflags/buildflags.h"
 #include "brave/components/brave_sync/features.h"
 #include "brave/components/brave_wallet/buildflags/buildflags.h"
+#include "brave/components/p3a/brave_p3a_service.h"
+#include "brave/components/p3a/buildflags.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "chrome/common/chrome_features.h"
 #include "components/prefs/pref_service.h"
@@ -127,6 +130,9 @@ void BraveBrowserMainParts::PostBrowserStart() {
 }
 
 void BraveBrowserMainParts::PreShutdown() {
+#if BUILDFLAG(BRAVE_P3A_ENABLED)
+  g_brave_browser_process->brave_p3a_service()->OnShutdown();
+#endif
   content::BraveClearBrowsingData::ClearOnExit();
 }
 
@@ -106,7 +106,11 @@ using extensions::ChromeContentBrowserClientExtensionsPart;
 #endif
 
 #if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/speedreader/speedreader_service_factory.h"
 #include "brave/browser/speedreader/speedreader_tab_helper.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+#include "brave/components/speedreader/speedreader_rewriter_service.h"
+#include "brave/components/speedreader/speedreader_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #endif
@@ -385,9 +389,18 @@ BraveContentBrowserClient::CreateURLLoaderThrottles(
   if (tab_helper && tab_helper->IsActiveForMainFrame() &&
       request.resource_type ==
           static_cast<int>(blink::mojom::ResourceType::kMainFrame)) {
+    base::WeakPtr<speedreader::SpeedreaderDistilledPageCache>
+        distilled_page_cache;
+    if (!browser_context->IsOffTheRecord()) {
+      distilled_page_cache =
+          speedreader::SpeedreaderServiceFactory::GetForProfile(
+              Profile::FromBrowserContext(browser_context))
+              ->distilled_page_cache()
+              ->GetWeakPtr();
+    }
     result.push_back(std::make_unique<speedreader::SpeedReaderThrottle>(
         g_brave_browser_process->speedreader_rewriter_service(),
-        base::ThreadTaskRunnerHandle::Get()));
+        std::move(distilled_page_cache), base::ThreadTaskRunnerHandle::Get()));
   }
 #endif  // ENABLE_SPEEDREADER
   return result;
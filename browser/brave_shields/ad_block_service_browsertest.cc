@@ -11,15 +11,18 @@
 #include "base/base64.h"
 #include "base/path_service.h"
 #include "base/task/post_task.h"
+#include "base/test/test_mock_time_task_runner.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
+#include "brave/common/extensions/api/brave_shields.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -33,6 +36,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/event_router.h"
 #include "extensions/test/extension_test_message_listener.h"
 #include "net/dns/mock_host_resolver.h"
 
@@ -79,6 +83,9 @@ using content::BrowserThread;
 void AdBlockServiceTest::SetUpOnMainThread() {
   ExtensionBrowserTest::SetUpOnMainThread();
   host_resolver()->AddRule("*", "127.0.0.1");
+  // Tests check the blocked counts as soon as a resource is blocked
+  brave_shields::BraveShieldsWebContentsObserver::
+      SetWriteStatsImmediatelyForTesting(true);
 }
 
 void AdBlockServiceTest::SetUp() {
@@ -100,6 +107,7 @@ void AdBlockServiceTest::UpdateAdBlockInstanceWithRules(
     const std::string& rules,
     const std::string& resources) {
   g_brave_browser_process->ad_block_service()->ResetForTest(rules, resources);
+  WaitForAdBlockServiceThreads();
 }
 
 void AdBlockServiceTest::AssertTagExists(const std::string& tag,
@@ -1153,3 +1161,104 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringIframeScriptlet) {
 
   ASSERT_EQ(true, EvalJs(contents, "show_ad"));
 }
+
+// Records the batches of blocked resources dispatched to extensions.
+class BlockedResourcesEventObserver
+    : public extensions::EventRouter::TestObserver {
+ public:
+  explicit BlockedResourcesEventObserver(extensions::EventRouter* event_router)
+      : event_router_(event_router) {
+    event_router_->AddObserverForTesting(this);
+  }
+  ~BlockedResourcesEventObserver() override {
+    event_router_->RemoveObserverForTesting(this);
+  }
+
+  // extensions::EventRouter::TestObserver overrides
+  void OnWillDispatchEvent(const extensions::Event& event) override {
+    if (event.event_name ==
+        extensions::api::brave_shields::OnBlockedResources::kEventName) {
+      batch_sizes_.push_back(event.event_args->GetList()[0].GetList().size());
+    } else if (event.event_name ==
+               extensions::api::brave_shields::OnBlocked::kEventName) {
+      single_events_++;
+    }
+  }
+  void OnDidDispatchEventToProcess(const extensions::Event& event) override {}
+
+  const std::vector<size_t>& batch_sizes() const { return batch_sizes_; }
+  int single_events() const { return single_events_; }
+
+ private:
+  extensions::EventRouter* event_router_;
+  std::vector<size_t> batch_sizes_;
+  int single_events_ = 0;
+};
+
+// Runs the batching timers of new tabs on a mock clock instead of writing
+// stats immediately.
+class AdBlockServiceBatchingTest : public AdBlockServiceTest {
+ public:
+  void SetUpOnMainThread() override {
+    AdBlockServiceTest::SetUpOnMainThread();
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetWriteStatsImmediatelyForTesting(false);
+    task_runner_ = base::MakeRefCounted<base::TestMockTimeTaskRunner>();
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetTimerTaskRunnerForTesting(task_runner_,
+                                     task_runner_->GetMockTickClock());
+  }
+
+  void TearDownOnMainThread() override {
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetTimerTaskRunnerForTesting(nullptr, nullptr);
+    AdBlockServiceTest::TearDownOnMainThread();
+  }
+
+ protected:
+  scoped_refptr<base::TestMockTimeTaskRunner> task_runner_;
+};
+
+// Blocked resources go out as one event per 100 ms batch, and the lifetime
+// stats are written back every 5 seconds.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceBatchingTest, BatchesBlockedResources) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  WaitForBraveExtensionShieldsDataReady();
+  extensions::EventRouter* event_router =
+      extensions::EventRouter::Get(browser()->profile());
+  ASSERT_TRUE(event_router->HasEventListener(
+      extensions::api::brave_shields::OnBlockedResources::kEventName));
+  BlockedResourcesEventObserver event_observer(event_router);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+
+  // The observer of a new tab picks up the mock timers.
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ui_test_utils::NavigateToURLWithDisposition(
+      browser(), url, WindowOpenDisposition::NEW_FOREGROUND_TAB,
+      ui_test_utils::BROWSER_TEST_WAIT_FOR_LOAD_STOP);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 1);"
+                         "xhr('adbanner.js?1')"));
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 2);"
+                         "xhr('adbanner.js?2')"));
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 3);"
+                         "xhr('adbanner.js?3')"));
+
+  // Nothing is dispatched or written until the timers fire.
+  EXPECT_TRUE(event_observer.batch_sizes().empty());
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+
+  task_runner_->FastForwardBy(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(std::vector<size_t>({3}), event_observer.batch_sizes());
+  EXPECT_EQ(0, event_observer.single_events());
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+
+  task_runner_->FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 3ULL);
+  EXPECT_EQ(1u, event_observer.batch_sizes().size());
+}
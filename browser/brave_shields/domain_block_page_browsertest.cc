@@ -7,6 +7,7 @@
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -299,6 +300,65 @@ IN_PROC_BROWSER_TEST_F(DomainBlockTest, NoFetch) {
   ASSERT_EQ(0, request_count_);
 }
 
+IN_PROC_BROWSER_TEST_F(DomainBlockTest, AllowedURLIsNotDeferred) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
+  GURL other_url = embedded_test_server()->GetURL("a.com", "/blocking.html");
+
+  // The first navigation to the page has to wait for the ad block service.
+  base::HistogramTester histogram_tester;
+  NavigateTo(url);
+  histogram_tester.ExpectUniqueSample("Brave.DomainBlock.Deferred", true, 1);
+
+  // Once the page has been allowed, navigations to it proceed without being
+  // deferred. Other pages of a.com are still checked.
+  NavigateTo(url);
+  histogram_tester.ExpectBucketCount("Brave.DomainBlock.Deferred", false, 1);
+  NavigateTo(other_url);
+  ASSERT_FALSE(IsShowingInterstitial());
+  histogram_tester.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 2);
+
+  // Updating the rules drops the allowed URLs, so blocking a.com is still
+  // caught.
+  BlockDomainByURL(url);
+  NavigateTo(url);
+  ASSERT_TRUE(IsShowingInterstitial());
+  histogram_tester.ExpectBucketCount("Brave.DomainBlock.Deferred", true, 3);
+}
+
+IN_PROC_BROWSER_TEST_F(DomainBlockTest, AllowedRootDoesNotAllowBlockedPath) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("||a.com^*/blocking.html$document");
+  GURL url = embedded_test_server()->GetURL("a.com", "/");
+  GURL blocked_url = embedded_test_server()->GetURL("a.com", "/blocking.html");
+
+  // Let the pre-filter remember the root of a.com
+  NavigateTo(url);
+  ASSERT_FALSE(IsShowingInterstitial());
+  NavigateTo(url);
+  ASSERT_FALSE(IsShowingInterstitial());
+
+  // The blocked page is still checked against the rules
+  NavigateTo(blocked_url);
+  ASSERT_TRUE(IsShowingInterstitial());
+}
+
+IN_PROC_BROWSER_TEST_F(DomainBlockTest, OffTheRecordURLsAreNotRemembered) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
+
+  // Navigations in a private window are always checked, and don't let later
+  // navigations skip the check.
+  base::HistogramTester histogram_tester;
+  Browser* incognito_browser = CreateIncognitoBrowser(browser()->profile());
+  ui_test_utils::NavigateToURL(incognito_browser, url);
+  ui_test_utils::NavigateToURL(incognito_browser, url);
+  histogram_tester.ExpectUniqueSample("Brave.DomainBlock.Deferred", true, 2);
+
+  NavigateTo(url);
+  histogram_tester.ExpectUniqueSample("Brave.DomainBlock.Deferred", true, 3);
+}
+
 IN_PROC_BROWSER_TEST_F(DomainBlockDisabledTest, NoInterstitial) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
   GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
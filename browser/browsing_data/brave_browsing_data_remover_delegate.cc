@@ -21,6 +21,12 @@
 #include "extensions/browser/event_router.h"
 #endif
 
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/speedreader/speedreader_service_factory.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+#include "brave/components/speedreader/speedreader_service.h"
+#endif
+
 #if BUILDFLAG(IPFS_ENABLED)
 #include "base/command_line.h"
 #include "base/files/file_path.h"
@@ -63,6 +69,13 @@ void BraveBrowsingDataRemoverDelegate::RemoveEmbedderData(
   if (remove_mask & chrome_browsing_data_remover::DATA_TYPE_CONTENT_SETTINGS)
     ClearShieldsSettings(delete_begin, delete_end);
 
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+  if (remove_mask & (content::BrowsingDataRemover::DATA_TYPE_CACHE |
+                     chrome_browsing_data_remover::DATA_TYPE_HISTORY)) {
+    ClearSpeedreaderCache();
+  }
+#endif
+
 #if BUILDFLAG(IPFS_ENABLED)
   if (remove_mask & content::BrowsingDataRemover::DATA_TYPE_CACHE)
     ClearIPFSCache();
@@ -114,6 +127,19 @@ void BraveBrowsingDataRemoverDelegate::ClearShieldsSettings(
   }
 }
 
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+// Distilled pages are only kept in memory and are not timestamped, so they are
+// all dropped whatever the time range.
+void BraveBrowsingDataRemoverDelegate::ClearSpeedreaderCache() {
+  if (profile_->IsOffTheRecord())
+    return;
+
+  speedreader::SpeedreaderServiceFactory::GetForProfile(profile_)
+      ->distilled_page_cache()
+      ->Clear();
+}
+#endif  // BUILDFLAG(ENABLE_SPEEDREADER)
+
 #if BUILDFLAG(IPFS_ENABLED)
 void BraveBrowsingDataRemoverDelegate::WaitForIPFSRepoGC(
     base::Process process) {
@@ -9,6 +9,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
+#include "brave/components/speedreader/buildflags.h"
 #include "chrome/browser/browsing_data/chrome_browsing_data_remover_delegate.h"
 
 namespace base {
@@ -47,6 +48,9 @@ class BraveBrowsingDataRemoverDelegate
                           override;
 
   void ClearShieldsSettings(base::Time begin_time, base::Time end_time);
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+  void ClearSpeedreaderCache();
+#endif
 #if BUILDFLAG(IPFS_ENABLED)
   void ClearIPFSCache();
   void WaitForIPFSRepoGC(base::Process process);
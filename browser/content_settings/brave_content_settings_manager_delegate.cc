@@ -8,7 +8,9 @@
 #include <memory>
 #include <utility>
 
+#include "base/compiler_specific.h"
 #include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/ephemeral_storage/ephemeral_storage_tab_helper.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -39,6 +41,25 @@ bool ShouldStoreState(int render_process_id,
                          render_frame_id, url);
 }
 
+// Third-party frames may end up using ephemeral DOM storage, whose namespaces
+// are created by the tab helper on demand rather than on every navigation.
+void EnsureEphemeralStorageAreas(int render_process_id, int render_frame_id) {
+  content::RenderFrameHost* frame =
+      content::RenderFrameHost::FromID(render_process_id, render_frame_id);
+  if (!frame || !frame->GetParent())
+    return;
+
+  content::WebContents* web_contents =
+      content::WebContents::FromRenderFrameHost(frame);
+  auto* tab_helper =
+      web_contents
+          ? ephemeral_storage::EphemeralStorageTabHelper::FromWebContents(
+                web_contents)
+          : nullptr;
+  if (tab_helper)
+    tab_helper->EnsureEphemeralStorageAreas();
+}
+
 }  // namespace
 
 BraveContentSettingsManagerDelegate::~BraveContentSettingsManagerDelegate() =
@@ -56,9 +77,11 @@ bool BraveContentSettingsManagerDelegate::AllowStorageAccess(
       content_settings::mojom::ContentSettingsManager::StorageType;
   // LOCAL_STORAGE | SESSION_STORAGE == DOMStorage
   switch (storage_type) {
-    case StorageType::DATABASE:
     case StorageType::LOCAL_STORAGE:
     case StorageType::SESSION_STORAGE:
+      EnsureEphemeralStorageAreas(render_process_id, render_frame_id);
+      FALLTHROUGH;
+    case StorageType::DATABASE:
     case StorageType::INDEXED_DB:
       if (!ShouldStoreState(render_process_id, render_frame_id, url)) {
         std::move(*callback).Run(false);
@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <string>
+#include <vector>
 
 #include "base/path_service.h"
 #include "brave/common/brave_paths.h"
@@ -338,6 +339,75 @@ IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
   EXPECT_EQ("", values_after.iframe_2.cookies);
 }
 
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       ClosingManyTabsClearsEphemeralStorage) {
+  constexpr int kTabCount = 100;
+
+  std::vector<WebContents*> site_a_tabs;
+  for (int i = 0; i < kTabCount; ++i)
+    site_a_tabs.push_back(LoadURLInNewTab(a_site_ephemeral_storage_url_));
+  EXPECT_EQ(browser()->tab_strip_model()->count(), kTabCount + 1);
+
+  SetValuesInFrames(site_a_tabs.back(), "a.com value", "from=a.com");
+  ValuesFromFrames values_before = GetValuesFromFrames(site_a_tabs.front());
+  EXPECT_EQ("a.com value", values_before.iframe_1.local_storage);
+  EXPECT_EQ(nullptr, values_before.iframe_1.session_storage);
+  EXPECT_EQ("from=a.com", values_before.iframe_1.cookies);
+
+  // Close all a.com tabs at once, ephemeral storage goes away with the last
+  // one.
+  while (browser()->tab_strip_model()->count() > 1) {
+    EXPECT_TRUE(browser()->tab_strip_model()->CloseWebContentsAt(
+        1, TabStripModel::CloseTypes::CLOSE_NONE));
+  }
+
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+
+  ValuesFromFrames values_after = GetValuesFromFrames(web_contents);
+  EXPECT_EQ("a.com value", values_after.main_frame.local_storage);
+  EXPECT_EQ(nullptr, values_after.iframe_1.local_storage);
+  EXPECT_EQ(nullptr, values_after.iframe_2.local_storage);
+
+  EXPECT_EQ("from=a.com", values_after.main_frame.cookies);
+  EXPECT_EQ("", values_after.iframe_1.cookies);
+  EXPECT_EQ("", values_after.iframe_2.cookies);
+}
+
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       ClosingTabKeepsStorageOfOtherTabsWithSameDomain) {
+  WebContents* first_site_a_tab =
+      LoadURLInNewTab(a_site_ephemeral_storage_url_);
+  // This page has no third-party frames, so the second tab shares the storage
+  // domain without ever touching ephemeral storage itself.
+  LoadURLInNewTab(https_server_.GetURL("a.com", "/simple.html"));
+  EXPECT_EQ(browser()->tab_strip_model()->count(), 3);
+
+  SetValuesInFrames(first_site_a_tab, "a.com value", "from=a.com");
+
+  // Close the only tab which used ephemeral storage. The second a.com tab is
+  // still open, so ephemeral storage has to stay around.
+  int tab_index =
+      browser()->tab_strip_model()->GetIndexOfWebContents(first_site_a_tab);
+  EXPECT_TRUE(browser()->tab_strip_model()->CloseWebContentsAt(
+      tab_index, TabStripModel::CloseTypes::CLOSE_NONE));
+
+  // Navigate the second tab within the same storage domain.
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+
+  ValuesFromFrames values_after = GetValuesFromFrames(web_contents);
+  EXPECT_EQ("a.com value", values_after.iframe_1.local_storage);
+  EXPECT_EQ("a.com value", values_after.iframe_2.local_storage);
+
+  // Session storage is per-tab and went away with the first tab.
+  EXPECT_EQ(nullptr, values_after.iframe_1.session_storage);
+  EXPECT_EQ(nullptr, values_after.iframe_2.session_storage);
+
+  EXPECT_EQ("from=a.com", values_after.iframe_1.cookies);
+  EXPECT_EQ("from=a.com", values_after.iframe_2.cookies);
+}
+
 IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
                        ReloadDoesNotClearEphemeralStorage) {
   ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
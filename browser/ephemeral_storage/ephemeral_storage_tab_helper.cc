@@ -7,6 +7,7 @@
 
 #include <map>
 #include <set>
+#include <utility>
 
 #include "base/feature_list.h"
 #include "base/hash/md5.h"
@@ -15,6 +16,7 @@
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/tld_ephemeral_lifetime.h"
 #include "content/public/browser/web_contents.h"
 #include "net/base/features.h"
 #include "net/base/url_util.h"
@@ -57,8 +59,7 @@ EphemeralStorageTabHelper::EphemeralStorageTabHelper(WebContents* web_contents)
   // The URL might not be empty if this is a restored WebContents, for instance.
   // In that case we want to make sure it has valid ephemeral storage.
   const GURL& url = web_contents->GetLastCommittedURL();
-  CreateEphemeralStorageAreasForDomainAndURL(
-      net::URLToEphemeralStorageDomain(url), url);
+  SetStorageDomainAndURL(net::URLToEphemeralStorageDomain(url), url);
 }
 
 EphemeralStorageTabHelper::~EphemeralStorageTabHelper() {}
@@ -77,55 +78,75 @@ void EphemeralStorageTabHelper::ReadyToCommitNavigation(
   if (new_domain == previous_domain)
     return;
 
-  CreateEphemeralStorageAreasForDomainAndURL(new_domain, new_url);
+  SetStorageDomainAndURL(new_domain, new_url);
 }
 
-void EphemeralStorageTabHelper::CreateEphemeralStorageAreasForDomainAndURL(
-    std::string new_domain,
-    const GURL& new_url) {
+void EphemeralStorageTabHelper::SetStorageDomainAndURL(std::string new_domain,
+                                                       const GURL& new_url) {
   if (new_url.is_empty())
     return;
 
+  // The session storage namespace of the previous domain is released right
+  // away, the local storage one goes away with the last reference to the
+  // previous TLDEphemeralLifetime. The ones of the new domain are created on
+  // first use, see EnsureEphemeralStorageAreas().
+  session_storage_namespace_.reset();
+  storage_domain_ = std::move(new_domain);
+  storage_url_ = new_url;
+
+  // Ephemeral cookies may be set by the network stack without any renderer
+  // involvement, so their lifetime starts right away.
+  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
+      web_contents()->GetBrowserContext(), GetStoragePartition(),
+      storage_domain_);
+}
+
+content::StoragePartition* EphemeralStorageTabHelper::GetStoragePartition() {
   auto* browser_context = web_contents()->GetBrowserContext();
   auto site_instance =
-      content::SiteInstance::CreateForURL(browser_context, new_url);
-  auto* partition =
-      BrowserContext::GetStoragePartition(browser_context, site_instance.get());
-
-  // This will fetch a session storage namespace for this storage partition
-  // and storage domain. If another tab helper is already using the same
-  // namespace, this will just give us a new reference. When the last tab helper
-  // drops the reference, the namespace should be deleted.
-  std::string local_partition_id =
-      StringToSessionStorageId(new_domain, kLocalStorageSuffix);
-  local_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, local_partition_id, base::nullopt);
-
-  // Session storage is always per-tab and never per-TLD, so we always delete
-  // and recreate the session storage when switching domains.
-  //
-  // We need to explicitly release the storage namespace before recreating a
-  // new one in order to make sure that we remove the final reference and free
-  // it.
-  session_storage_namespace_.reset();
+      content::SiteInstance::CreateForURL(browser_context, storage_url_);
+  return BrowserContext::GetStoragePartition(browser_context,
+                                             site_instance.get());
+}
+
+void EphemeralStorageTabHelper::EnsureEphemeralStorageAreas() {
+  if (storage_url_.is_empty() || session_storage_namespace_)
+    return;
 
+  auto* partition = GetStoragePartition();
+
+  // The local storage namespace is shared by all tabs of this storage domain,
+  // so it is owned by their common TLDEphemeralLifetime rather than by the tab
+  // which happens to use it first. Otherwise closing that tab would clear
+  // local storage while other tabs of the same domain are still open.
+  if (!tld_ephemeral_lifetime_->local_storage_namespace()) {
+    std::string local_partition_id =
+        StringToSessionStorageId(storage_domain_, kLocalStorageSuffix);
+    tld_ephemeral_lifetime_->SetLocalStorageNamespace(
+        content::CreateSessionStorageNamespace(partition, local_partition_id,
+                                               base::nullopt));
+  }
+
+  // Session storage is always per-tab and never per-TLD, so it was deleted
+  // when switching domains and is recreated here.
   std::string session_partition_id = StringToSessionStorageId(
       content::GetSessionStorageNamespaceId(web_contents()),
       kSessionStorageSuffix);
 
-  auto* rfh = web_contents()->GetOpener();
+  // Clone the namespace if there is an opener which has one
+  // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
+  base::Optional<std::string> clone_from_namespace_id;
+  if (auto* rfh = web_contents()->GetOpener()) {
+    WebContents* opener = WebContents::FromRenderFrameHost(rfh);
+    auto* opener_tab_helper = FromWebContents(opener);
+    if (opener_tab_helper && opener_tab_helper->session_storage_namespace_) {
+      clone_from_namespace_id = StringToSessionStorageId(
+          content::GetSessionStorageNamespaceId(opener),
+          kSessionStorageSuffix);
+    }
+  }
   session_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, session_partition_id,
-      // clone the namespace if there is an opener
-      // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
-      rfh ? base::make_optional<std::string>(StringToSessionStorageId(
-                content::GetSessionStorageNamespaceId(
-                    WebContents::FromRenderFrameHost(rfh)),
-                kSessionStorageSuffix))
-          : base::nullopt);
-
-  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
-      browser_context, partition, new_domain);
+      partition, session_partition_id, clone_from_namespace_id);
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(EphemeralStorageTabHelper)
@@ -13,9 +13,11 @@
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "url/gurl.h"
 
 namespace content {
 class BrowserContext;
+class StoragePartition;
 class WebContents;
 }  // namespace content
 
@@ -25,7 +27,10 @@ namespace ephemeral_storage {
 // Ephemeral storage is a partitioned storage area only used by third-party
 // iframes. This storage is partitioned based on the origin of the TLD
 // of the main frame. When no more tabs are open with a particular origin,
-// this storage is cleared.
+// this storage is cleared. The storage namespaces are only created once a
+// third-party frame of the tab uses DOM storage. The local storage namespace
+// is then kept alive by the TLDEphemeralLifetime, which is shared by all tabs
+// of the storage domain, while the session storage namespace is per-tab.
 class EphemeralStorageTabHelper
     : public content::WebContentsObserver,
       public content::WebContentsUserData<EphemeralStorageTabHelper> {
@@ -33,16 +38,22 @@ class EphemeralStorageTabHelper
   explicit EphemeralStorageTabHelper(content::WebContents* web_contents);
   ~EphemeralStorageTabHelper() override;
 
+  // Creates the ephemeral storage namespaces of the current storage domain
+  // unless they exist already. This has to happen before a renderer binds
+  // them.
+  void EnsureEphemeralStorageAreas();
+
  protected:
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
 
  private:
-  void CreateEphemeralStorageAreasForDomainAndURL(std::string new_domain,
-                                                  const GURL& new_url);
+  void SetStorageDomainAndURL(std::string new_domain, const GURL& new_url);
+  content::StoragePartition* GetStoragePartition();
 
   friend class content::WebContentsUserData<EphemeralStorageTabHelper>;
-  scoped_refptr<content::SessionStorageNamespace> local_storage_namespace_;
+  std::string storage_domain_;
+  GURL storage_url_;
   scoped_refptr<content::SessionStorageNamespace> session_storage_namespace_;
   scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime_;
 
@@ -187,3 +187,39 @@ IN_PROC_BROWSER_TEST_F(BraveWebGLFarblingBrowserTest,
     ASSERT_EQ(DiffsAsString(real_values, farbled_values), expected_diff);
   }
 }
+
+// Farbled WebGL calls reuse the farbling level decided for the page. Repeated
+// calls must give the same result, and a settings change must be picked up by
+// the next page load.
+IN_PROC_BROWSER_TEST_F(BraveWebGLFarblingBrowserTest,
+                       FarblingLevelIsConsistentAcrossCalls) {
+  const std::string script =
+      "var gl = document.getElementById('test').getContext('webgl2');"
+      "var values = new Set();"
+      "for (var i = 0; i < 1000; i++) {"
+      "  values.add(String(gl.getParameter(gl.MAX_VERTEX_UNIFORM_COMPONENTS)));"
+      "}"
+      "domAutomationController.send(Array.from(values).join(' '));";
+  std::string domain = "a.com";
+  GURL url = embedded_test_server()->GetURL(domain, "/webgl2-parameters.html");
+
+  AllowFingerprinting(domain);
+  NavigateToURLUntilLoadStop(url);
+  const std::string real_value = ExecScriptGetStr(script, contents());
+  int64_t real = 0;
+  ASSERT_TRUE(base::StringToInt64(real_value, &real));
+
+  // For a.com this parameter is off by one, see FarbleGetParameterWebGL2.
+  SetFingerprintingDefault(domain);
+  NavigateToURLUntilLoadStop(url);
+  EXPECT_EQ(base::NumberToString(real - 1),
+            ExecScriptGetStr(script, contents()));
+
+  BlockFingerprinting(domain);
+  NavigateToURLUntilLoadStop(url);
+  EXPECT_EQ("null", ExecScriptGetStr(script, contents()));
+
+  AllowFingerprinting(domain);
+  NavigateToURLUntilLoadStop(url);
+  EXPECT_EQ(real_value, ExecScriptGetStr(script, contents()));
+}
@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/task/post_task.h"
@@ -20,6 +21,7 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
+#include "chrome/common/chrome_paths.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
@@ -134,6 +136,12 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
         ->size();
   }
 
+  base::FilePath GetBundlesDir() {
+    base::FilePath bundles_dir;
+    base::PathService::Get(chrome::DIR_USER_DATA, &bundles_dir);
+    return bundles_dir.AppendASCII("Greaselion").AppendASCII("Bundles");
+  }
+
   void ClearRules() {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
@@ -364,6 +372,60 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   EXPECT_FALSE(greaselion_service->IsGreaselionExtension("INVALID"));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       PRE_ExtensionsLoadedFromBundles) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  for (const auto& id : extension_ids) {
+    const extensions::Extension* extension =
+        extension_registry()->enabled_extensions().GetByID(id);
+    ASSERT_TRUE(extension);
+    EXPECT_EQ(GetBundlesDir(), extension->path().DirName());
+  }
+
+  // Setting a feature to its current state does not reinstall anything
+  greaselion_service->SetFeatureEnabled(greaselion::REWARDS, false);
+  EXPECT_TRUE(greaselion_service->ready());
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+}
+
+// The bundles converted before the restart are loaded as-is
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ExtensionsLoadedFromBundles) {
+  // Hand the component installed before the restart to the download service
+  // again, instead of reinstalling it with new files
+  const extensions::Extension* mock_extension = nullptr;
+  for (const auto& extension : extension_registry()->enabled_extensions()) {
+    if (extension->name() == "Local Data Files Updater")
+      mock_extension = extension.get();
+  }
+  ASSERT_TRUE(mock_extension);
+  service()->OnComponentReady(mock_extension->id(), mock_extension->path(),
+                              "");
+  WaitForService();
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  for (const auto& id : extension_ids) {
+    const extensions::Extension* extension =
+        extension_registry()->enabled_extensions().GetByID(id);
+    ASSERT_TRUE(extension);
+    EXPECT_EQ(GetBundlesDir(), extension->path().DirName());
+  }
+  EXPECT_EQ(static_cast<int>(extension_ids.size()),
+            greaselion_service->GetReusedBundleCountForTesting());
+  EXPECT_EQ(0, greaselion_service->GetConvertedBundleCountForTesting());
+}
+
 
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
                       ScriptInjectionWithBrowserVersionConditionLowWild) {
@@ -99,6 +99,21 @@ void BraveExternalProcessImporterClient::OnImportItemFinished(
   brave_profile_import_->ReportImportItemFinished(import_item);
 }
 
+void BraveExternalProcessImporterClient::OnHistoryImportGroup(
+    const std::vector<ImporterURLRow>& history_rows_group,
+    int visit_source) {
+  ExternalProcessImporterClient::OnHistoryImportGroup(history_rows_group,
+                                                      visit_source);
+  if (!ShouldUseBraveImporter(source_profile_.importer_type))
+    return;
+
+  // The brave importer sends history in several batches and each one is
+  // written as soon as it is complete, so it doesn't have to be kept around
+  // or written again along with the next batch.
+  if (history_rows_.size() >= total_history_rows_count_)
+    history_rows_.clear();
+}
+
 void BraveExternalProcessImporterClient::OnCreditCardImportReady(
     const base::string16& name_on_card,
     const base::string16& expiration_month,
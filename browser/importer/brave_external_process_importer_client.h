@@ -7,6 +7,7 @@
 #define BRAVE_BROWSER_IMPORTER_BRAVE_EXTERNAL_PROCESS_IMPORTER_CLIENT_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string16.h"
@@ -35,6 +36,9 @@ class BraveExternalProcessImporterClient
   void Cancel() override;
   void CloseMojoHandles() override;
   void OnImportItemFinished(importer::ImportItem import_item) override;
+  void OnHistoryImportGroup(
+      const std::vector<ImporterURLRow>& history_rows_group,
+      int visit_source) override;
 
   // brave::mojom::ProfileImportObserver overrides:
   void OnCreditCardImportReady(
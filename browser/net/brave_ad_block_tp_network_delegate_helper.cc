@@ -12,6 +12,7 @@
 
 #include "base/base64url.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
@@ -54,8 +55,8 @@ content::WebContents* GetWebContents(int render_process_id,
 
 }  // namespace
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx,
-                               base::Optional<std::string> canonical_name) {
+void ShouldBlockAdOnWorker(std::shared_ptr<BraveRequestInfo> ctx,
+                           base::Optional<std::string> canonical_name) {
   bool did_match_rule = false;
   bool did_match_exception = false;
   bool did_match_important = false;
@@ -101,14 +102,15 @@ void OnShouldBlockAdResult(const ResponseCallback& next_callback,
   next_callback.Run();
 }
 
-void ShouldBlockAdWithOptionalCname(
-    scoped_refptr<base::SequencedTaskRunner> task_runner,
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx,
-    const base::Optional<std::string> cname) {
+void ShouldBlockAdWithOptionalCname(const ResponseCallback& next_callback,
+                                    std::shared_ptr<BraveRequestInfo> ctx,
+                                    const base::Optional<std::string> cname) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  task_runner->PostTaskAndReply(
-      FROM_HERE, base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx, cname),
+  // The ad-block engines may be queried from any thread, so requests are
+  // matched in parallel rather than one at a time on the service's sequence.
+  base::PostTaskAndReply(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&ShouldBlockAdOnWorker, ctx, cname),
       base::BindOnce(&OnShouldBlockAdResult, next_callback, ctx));
 }
 
@@ -119,11 +121,9 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   base::TimeTicks start_time_;
 
  public:
-  AdblockCnameResolveHostClient(
-      const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
-      std::shared_ptr<BraveRequestInfo> ctx) {
-    cb_ = base::BindOnce(&ShouldBlockAdWithOptionalCname, task_runner,
+  AdblockCnameResolveHostClient(const ResponseCallback& next_callback,
+                                std::shared_ptr<BraveRequestInfo> ctx) {
+    cb_ = base::BindOnce(&ShouldBlockAdWithOptionalCname,
                          std::move(next_callback), ctx);
 
     auto* web_contents = GetWebContents(
@@ -197,18 +197,14 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
   DCHECK(!ctx->request_url.is_empty());
   DCHECK(!ctx->initiator_url.is_empty());
 
-  scoped_refptr<base::SequencedTaskRunner> task_runner =
-      g_brave_browser_process->ad_block_service()->GetTaskRunner();
-
   DCHECK(ctx->browser_context);
   // DoH or standard DNS quries won't be routed through Tor, so we need to skip
   // it.
   if (ctx->browser_context->IsTor()) {
-    ShouldBlockAdWithOptionalCname(task_runner, std::move(next_callback), ctx,
+    ShouldBlockAdWithOptionalCname(std::move(next_callback), ctx,
                                    base::nullopt);
   } else {
-    new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx);
+    new AdblockCnameResolveHostClient(std::move(next_callback), ctx);
   }
 }
 
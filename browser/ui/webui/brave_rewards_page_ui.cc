@@ -71,7 +71,7 @@ class RewardsDOMHandler : public WebUIMessageHandler,
   void RecoverWallet(const base::ListValue* args);
   void GetReconcileStamp(const base::ListValue* args);
   void SaveSetting(const base::ListValue* args);
-  void OnPublisherList(ledger::type::PublisherInfoList list);
+  void OnPublisherList(uint32_t cursor, ledger::type::PublisherInfoList list);
   void OnExcludedSiteList(ledger::type::PublisherInfoList list);
   void ExcludePublisher(const base::ListValue* args);
   void RestorePublishers(const base::ListValue* args);
@@ -81,6 +81,8 @@ class RewardsDOMHandler : public WebUIMessageHandler,
   void GetRecurringTips(const base::ListValue* args);
   void GetOneTimeTips(const base::ListValue* args);
   void GetContributionList(const base::ListValue* args);
+  void GetContributionListPage(const base::ListValue* args);
+  void FetchContributionListPage(uint32_t cursor);
   void GetAdsData(const base::ListValue* args);
   void GetAdsHistory(const base::ListValue* args);
   void OnGetAdsHistory(const base::ListValue& history);
@@ -298,6 +300,8 @@ class RewardsDOMHandler : public WebUIMessageHandler,
   void OnAdRewardsChanged() override;
 
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
+  // Filter of the auto-contribute list which is currently being paged through
+  ledger::type::ActivityInfoFilterPtr contribute_list_filter_;
   brave_ads::AdsService* ads_service_;  // NOT OWNED
   base::WeakPtrFactory<RewardsDOMHandler> weak_factory_;
 
@@ -314,6 +318,25 @@ const char kAdsSubdivisionTargeting[] = "adsSubdivisionTargeting";
 const char kAutoDetectedAdsSubdivisionTargeting[] =
     "automaticallyDetectedAdsSubdivisionTargeting";
 
+// Number of publishers sent to the page at once. The page asks for the next
+// page once it received the previous one.
+const uint32_t kContributeListPageSize = 200;
+
+std::unique_ptr<base::DictionaryValue> GetContributePublisherValue(
+    const ledger::type::PublisherInfo& info) {
+  auto publisher = std::make_unique<base::DictionaryValue>();
+  publisher->SetString("id", info.id);
+  publisher->SetDouble("percentage", info.percent);
+  publisher->SetString("publisherKey", info.id);
+  publisher->SetInteger("status", static_cast<int>(info.status));
+  publisher->SetInteger("excluded", static_cast<int>(info.excluded));
+  publisher->SetString("name", info.name);
+  publisher->SetString("provider", info.provider);
+  publisher->SetString("url", info.url);
+  publisher->SetString("favIcon", info.favicon_url);
+  return publisher;
+}
+
 }  // namespace
 
 RewardsDOMHandler::RewardsDOMHandler() : weak_factory_(this) {}
@@ -389,6 +412,9 @@ void RewardsDOMHandler::RegisterMessages() {
   web_ui()->RegisterMessageCallback("brave_rewards.getContributionList",
       base::BindRepeating(&RewardsDOMHandler::GetContributionList,
       base::Unretained(this)));
+  web_ui()->RegisterMessageCallback("brave_rewards.getContributionListPage",
+      base::BindRepeating(&RewardsDOMHandler::GetContributionListPage,
+      base::Unretained(this)));
   web_ui()->RegisterMessageCallback("brave_rewards.getAdsData",
       base::BindRepeating(&RewardsDOMHandler::GetAdsData,
       base::Unretained(this)));
@@ -773,12 +799,22 @@ void RewardsDOMHandler::OnAutoContributePropsReady(
   filter->non_verified = properties->contribution_non_verified;
   filter->min_visits = properties->contribution_min_visits;
 
+  contribute_list_filter_ = std::move(filter);
+  FetchContributionListPage(0);
+}
+
+void RewardsDOMHandler::FetchContributionListPage(uint32_t cursor) {
+  if (!rewards_service_ || !contribute_list_filter_) {
+    return;
+  }
+
   rewards_service_->GetActivityInfoList(
-      0,
-      0,
-      std::move(filter),
+      cursor,
+      kContributeListPageSize,
+      contribute_list_filter_->Clone(),
       base::Bind(&RewardsDOMHandler::OnPublisherList,
-                 weak_factory_.GetWeakPtr()));
+                 weak_factory_.GetWeakPtr(),
+                 cursor));
 }
 
 void RewardsDOMHandler::GetExcludedSites(const base::ListValue* args) {
@@ -906,29 +942,30 @@ void RewardsDOMHandler::RestorePublisher(const base::ListValue *args) {
   rewards_service_->SetPublisherExclude(publisherKey, false);
 }
 
-void RewardsDOMHandler::OnPublisherList(ledger::type::PublisherInfoList list) {
+void RewardsDOMHandler::OnPublisherList(
+    uint32_t cursor,
+    ledger::type::PublisherInfoList list) {
   if (!web_ui()->CanCallJavascript()) {
     return;
   }
 
   auto publishers = std::make_unique<base::ListValue>();
   for (auto const& item : list) {
-    auto publisher = std::make_unique<base::DictionaryValue>();
-    publisher->SetString("id", item->id);
-    publisher->SetDouble("percentage", item->percent);
-    publisher->SetString("publisherKey", item->id);
-    publisher->SetInteger("status", static_cast<int>(item->status));
-    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
-    publisher->SetString("name", item->name);
-    publisher->SetString("provider", item->provider);
-    publisher->SetString("url", item->url);
-    publisher->SetString("favIcon", item->favicon_url);
-    publishers->Append(std::move(publisher));
+    publishers->Append(GetContributePublisherValue(*item));
+  }
+
+  base::DictionaryValue page;
+  page.SetInteger("cursor", static_cast<int>(cursor));
+  // A short page is the last one
+  if (list.size() == kContributeListPageSize) {
+    page.SetInteger("nextCursor",
+                    static_cast<int>(cursor + kContributeListPageSize));
   }
+  page.Set("publishers", std::move(publishers));
 
   web_ui()->CallJavascriptFunctionUnsafe(
-      "brave_rewards.contributeList",
-      *publishers);
+      "brave_rewards.contributeListPage",
+      page);
 }
 
 void RewardsDOMHandler::OnExcludedSiteList(
@@ -1075,6 +1112,16 @@ void RewardsDOMHandler::GetContributionList(const base::ListValue *args) {
         weak_factory_.GetWeakPtr()));
 }
 
+void RewardsDOMHandler::GetContributionListPage(const base::ListValue *args) {
+  CHECK_EQ(1U, args->GetSize());
+  const int cursor = args->GetList()[0].GetInt();
+  if (cursor < 0) {
+    return;
+  }
+
+  FetchContributionListPage(static_cast<uint32_t>(cursor));
+}
+
 void RewardsDOMHandler::GetAdsData(const base::ListValue *args) {
   if (!ads_service_ || !web_ui()->CanCallJavascript()) {
     return;
@@ -1370,7 +1417,19 @@ void RewardsDOMHandler::OnPendingContributionSaved(
 void RewardsDOMHandler::OnPublisherListNormalized(
     brave_rewards::RewardsService* rewards_service,
     ledger::type::PublisherInfoList list) {
-  OnPublisherList(std::move(list));
+  if (!web_ui()->CanCallJavascript()) {
+    return;
+  }
+
+  // Only the changed rows are sent, the page merges them into its list
+  base::ListValue publishers;
+  for (auto const& item : list) {
+    publishers.Append(GetContributePublisherValue(*item));
+  }
+
+  web_ui()->CallJavascriptFunctionUnsafe(
+      "brave_rewards.contributeListChanged",
+      publishers);
 }
 
 void RewardsDOMHandler::GetStatement(
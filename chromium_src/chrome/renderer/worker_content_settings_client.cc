@@ -9,6 +9,15 @@
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 
 BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
+  // Called for every farbled canvas, WebGL and audio call.
+  const uint64_t generation =
+      content_setting_rules_ ? content_setting_rules_->brave_rules_generation
+                             : 0;
+  if (generation != 0 && generation == farbling_level_generation_ &&
+      farbling_level_) {
+    return *farbling_level_;
+  }
+
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
     const GURL& primary_url = top_frame_origin_.GetURL();
@@ -29,13 +38,18 @@ BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
           content_setting_rules_->fingerprinting_rules, primary_url);
     }
   }
+  BraveFarblingLevel farbling_level;
   if (setting == CONTENT_SETTING_BLOCK) {
-    return BraveFarblingLevel::MAXIMUM;
+    farbling_level = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
-    return BraveFarblingLevel::OFF;
+    farbling_level = BraveFarblingLevel::OFF;
   } else {
-    return BraveFarblingLevel::BALANCED;
+    farbling_level = BraveFarblingLevel::BALANCED;
   }
+
+  farbling_level_generation_ = generation;
+  farbling_level_ = farbling_level;
+  return farbling_level;
 }
 
 bool WorkerContentSettingsClient::AllowFingerprinting(
@@ -6,9 +6,17 @@
 #ifndef BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 #define BRAVE_CHROMIUM_SRC_CHROME_RENDERER_WORKER_CONTENT_SETTINGS_CLIENT_H_
 
-#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H         \
-  BraveFarblingLevel GetBraveFarblingLevel() override; \
-  bool AllowFingerprinting(bool enabled_per_settings) override;
+#include "base/optional.h"
+
+#define BRAVE_WORKER_CONTENT_SETTINGS_CLIENT_H                   \
+  BraveFarblingLevel GetBraveFarblingLevel() override;           \
+  bool AllowFingerprinting(bool enabled_per_settings) override;  \
+                                                                 \
+ private:                                                        \
+  uint64_t farbling_level_generation_ = 0;                       \
+  base::Optional<BraveFarblingLevel> farbling_level_;            \
+                                                                 \
+ public:
 
 #include "../../../../chrome/renderer/worker_content_settings_client.h"
 
@@ -6,10 +6,13 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+// |brave_rules_generation| isn't sent over IPC, it is assigned when rules are
+// received, so that renderers can tell that their compiled rules are stale.
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  uint64_t brave_rules_generation = 0;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
@@ -3,10 +3,23 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#define BRAVE_READ_RENDERER_CONTENT_SETTING_RULES_DATA_VIEW       \
-  data.ReadAutoplayRules(&out->autoplay_rules) &&                 \
-      data.ReadFingerprintingRules(&out->fingerprinting_rules) && \
-      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&
+#include <atomic>
+
+namespace {
+
+// Never returns 0, which is left for rules that weren't received over IPC.
+uint64_t GetNextBraveRulesGeneration() {
+  static std::atomic<uint64_t> generation{0};
+  return ++generation;
+}
+
+}  // namespace
+
+#define BRAVE_READ_RENDERER_CONTENT_SETTING_RULES_DATA_VIEW                 \
+  data.ReadAutoplayRules(&out->autoplay_rules) &&                           \
+      data.ReadFingerprintingRules(&out->fingerprinting_rules) &&           \
+      data.ReadBraveShieldsRules(&out->brave_shields_rules) &&              \
+      (out->brave_rules_generation = GetNextBraveRulesGeneration()) != 0 &&
 
 #include "../../../../../../components/content_settings/core/common/content_settings_mojom_traits.cc"
 
@@ -6,7 +6,17 @@
 #include "content/public/browser/tld_ephemeral_lifetime.h"
 
 #include <map>
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
 #include "base/no_destructor.h"
+#include "base/supports_user_data.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/session_storage_namespace.h"
+#include "content/public/browser/storage_partition.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 
 namespace content {
@@ -25,6 +35,60 @@ TLDEphemeralLifetimeMap& active_tld_storage_areas() {
   return *active_storage_areas.get();
 }
 
+constexpr char kPendingCookieDeletionsKey[] =
+    "brave_pending_ephemeral_cookie_deletions";
+
+// Ephemeral cookies of lifetimes which end during the same task, e.g. when a
+// window with many tabs is closed, are deleted together from a single task.
+// Domains which get a new lifetime before that keep their cookies. Pending
+// deletions are owned by the BrowserContext so that they are dropped along
+// with its storage partitions.
+class PendingCookieDeletions : public base::SupportsUserData::Data {
+ public:
+  static PendingCookieDeletions* FromBrowserContext(
+      BrowserContext* browser_context) {
+    auto* deletions = static_cast<PendingCookieDeletions*>(
+        browser_context->GetUserData(kPendingCookieDeletionsKey));
+    if (!deletions) {
+      deletions = new PendingCookieDeletions();
+      browser_context->SetUserData(kPendingCookieDeletionsKey,
+                                   base::WrapUnique(deletions));
+    }
+    return deletions;
+  }
+
+  void Add(const std::string& storage_domain,
+           StoragePartition* storage_partition) {
+    if (deletions_.empty()) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&PendingCookieDeletions::Flush,
+                                    weak_factory_.GetWeakPtr()));
+    }
+    deletions_[storage_domain] = storage_partition;
+  }
+
+  void Cancel(const std::string& storage_domain) {
+    deletions_.erase(storage_domain);
+  }
+
+ private:
+  PendingCookieDeletions() = default;
+
+  void Flush() {
+    std::map<std::string, StoragePartition*> deletions;
+    deletions.swap(deletions_);
+    for (const auto& deletion : deletions) {
+      auto filter = network::mojom::CookieDeletionFilter::New();
+      filter->ephemeral_storage_domain = deletion.first;
+      deletion.second->GetCookieManagerForBrowserProcess()->DeleteCookies(
+          std::move(filter), base::NullCallback());
+    }
+  }
+
+  std::map<std::string, StoragePartition*> deletions_;
+  base::WeakPtrFactory<PendingCookieDeletions> weak_factory_{this};
+};
+
 }  // namespace
 
 TLDEphemeralLifetime::TLDEphemeralLifetime(TLDEphemeralLifetimeKey key,
@@ -33,13 +97,12 @@ TLDEphemeralLifetime::TLDEphemeralLifetime(TLDEphemeralLifetimeKey key,
   DCHECK(active_tld_storage_areas().find(key) ==
          active_tld_storage_areas().end());
   active_tld_storage_areas().emplace(key, weak_factory_.GetWeakPtr());
+  PendingCookieDeletions::FromBrowserContext(key_.first)->Cancel(key_.second);
 }
 
 TLDEphemeralLifetime::~TLDEphemeralLifetime() {
-  auto filter = network::mojom::CookieDeletionFilter::New();
-  filter->ephemeral_storage_domain = key_.second;
-  storage_partition_->GetCookieManagerForBrowserProcess()->DeleteCookies(
-      std::move(filter), base::NullCallback());
+  PendingCookieDeletions::FromBrowserContext(key_.first)
+      ->Add(key_.second, storage_partition_);
 
   active_tld_storage_areas().erase(key_);
 }
@@ -64,4 +127,10 @@ scoped_refptr<TLDEphemeralLifetime> TLDEphemeralLifetime::GetOrCreate(
   return base::MakeRefCounted<TLDEphemeralLifetime>(key, storage_partition);
 }
 
+void TLDEphemeralLifetime::SetLocalStorageNamespace(
+    scoped_refptr<SessionStorageNamespace> local_storage_namespace) {
+  DCHECK(!local_storage_namespace_);
+  local_storage_namespace_ = std::move(local_storage_namespace);
+}
+
 }  // namespace content
@@ -26,13 +26,14 @@ using TLDEphemeralLifetimeKey =
     std::pair<content::BrowserContext*, std::string>;
 
 // This class is responsible for managing the lifetime of ephemeral storage
-// cookies. Each instance is shared by each top-level frame with the same
-// TLDEphemeralLifetimeKey. When the last top-level frame holding a reference
-// is destroyed or navigates to a new storage domain, storage will be
-// cleared.
+// cookies and local storage. Each instance is shared by each top-level frame
+// with the same TLDEphemeralLifetimeKey. When the last top-level frame holding
+// a reference is destroyed or navigates to a new storage domain, storage will
+// be cleared. Cookies of all lifetimes ending in the same task are deleted
+// together right after that task.
 //
-// TODO(mrobinson): Have this class also manage ephemeral local storage and
-// take care of handing out new instances of session storage.
+// TODO(mrobinson): Have this class also take care of handing out new
+// instances of session storage.
 class CONTENT_EXPORT TLDEphemeralLifetime
     : public base::RefCounted<TLDEphemeralLifetime> {
  public:
@@ -44,12 +45,22 @@ class CONTENT_EXPORT TLDEphemeralLifetime
       StoragePartition* storage_partition,
       std::string storage_domain);
 
+  // The ephemeral local storage namespace is created lazily by the first tab
+  // whose third-party frames use it and is then kept alive by this lifetime,
+  // so that it outlives that tab as long as other tabs share the lifetime.
+  SessionStorageNamespace* local_storage_namespace() const {
+    return local_storage_namespace_.get();
+  }
+  void SetLocalStorageNamespace(
+      scoped_refptr<SessionStorageNamespace> local_storage_namespace);
+
  private:
   friend class RefCounted<TLDEphemeralLifetime>;
   virtual ~TLDEphemeralLifetime();
 
   TLDEphemeralLifetimeKey key_;
   StoragePartition* storage_partition_;
+  scoped_refptr<SessionStorageNamespace> local_storage_namespace_;
 
   base::WeakPtrFactory<TLDEphemeralLifetime> weak_factory_{this};
 };
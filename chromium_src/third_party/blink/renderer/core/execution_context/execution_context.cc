@@ -218,6 +218,11 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
                                                     wtf_size_t length) {
+  auto cache_key = std::make_pair(seed, length);
+  auto it = random_strings_.find(cache_key);
+  if (it != random_strings_.end())
+    return it->second;
+
   uint8_t key[32];
   crypto::HMAC h(crypto::HMAC::SHA256);
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&domain_key_),
@@ -232,6 +237,7 @@ WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
         kLettersForRandomStrings[v % kLettersForRandomStringsLength];
     v = lfsr_next(v);
   }
+  random_strings_.emplace(std::move(cache_key), value);
   return value;
 }
 
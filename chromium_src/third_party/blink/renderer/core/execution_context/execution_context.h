@@ -8,7 +8,10 @@
 
 #include "../../../../../../../third_party/blink/renderer/core/execution_context/execution_context.h"
 
+#include <map>
 #include <random>
+#include <string>
+#include <utility>
 
 #include "base/callback.h"
 
@@ -55,6 +58,7 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  std::map<std::pair<std::string, wtf_size_t>, WTF::String> random_strings_;
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
@@ -52,8 +52,11 @@ bool ShouldUseEphemeralStorage(
 // as soon as a third-party frame needs ephemeral storage. They are then shared
 // by all third-party frames that are embedded in this Page.
 //
-// These namespaces are created in the browser process ahead of time. We ensure
-// that we are using the same namespace by using a common naming scheme.
+// The browser process creates the matching namespaces when a third-party frame
+// first asks for storage access, which happens synchronously before the
+// namespaces are bound here, and keeps the local storage one alive as long as
+// any tab uses the storage domain. We ensure that we are using the same
+// namespace by using a common naming scheme.
 class EphemeralStorageNamespaces
     : public GarbageCollected<EphemeralStorageNamespaces>,
       public Supplement<Page> {
@@ -64,8 +64,10 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
 #define BRAVE_WEBGL2_RENDERING_CONTEXT_BASE_GETPARAMETER                      \
   if (ExecutionContext* context = ExecutionContext::From(script_state)) {     \
     if (WebContentSettingsClient* settings =                                  \
-        brave::GetContentSettingsClientFor(context)) {                  \
-      if (settings->GetBraveFarblingLevel() == BraveFarblingLevel::MAXIMUM) { \
+            brave::GetContentSettingsClientFor(context)) {                    \
+      const BraveFarblingLevel farbling_level =                               \
+          settings->GetBraveFarblingLevel();                                  \
+      if (farbling_level == BraveFarblingLevel::MAXIMUM) {                    \
         switch (pname) {                                                      \
           case GL_SHADING_LANGUAGE_VERSION:                                   \
           case GL_VERSION:                                                    \
@@ -86,8 +88,7 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
           case GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS:                   \
             return ScriptValue::CreateNull(script_state->GetIsolate());       \
         }                                                                     \
-      } else if (settings->GetBraveFarblingLevel() ==                         \
-                 BraveFarblingLevel::BALANCED) {                              \
+      } else if (farbling_level == BraveFarblingLevel::BALANCED) {            \
         switch (pname) {                                                      \
           case GL_MAX_VERTEX_UNIFORM_COMPONENTS:                              \
             return FarbleGLIntParameter(this, script_state, pname, 1);        \
@@ -203,6 +203,10 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
           {base::ThreadPool(), base::MayBlock(),
            base::TaskPriority::BEST_EFFORT,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      db_read_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
       base_path_(profile_->GetPath().AppendASCII("ads_service")),
       last_idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
       last_idle_time_(0),
@@ -540,9 +544,15 @@ void AdsServiceImpl::Shutdown() {
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
 
+  pending_db_reads_.clear();
+
   const bool success =
       file_task_runner_->DeleteSoon(FROM_HERE, database_.release());
   VLOG_IF(1, !success) << "Failed to release database";
+
+  const bool read_only_success = db_read_task_runner_->DeleteSoon(
+      FROM_HERE, read_only_database_.release());
+  VLOG_IF(1, !read_only_success) << "Failed to release read-only database";
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -824,6 +834,8 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const bool success) {
 
   database_ = std::make_unique<ads::Database>(
       base_path_.AppendASCII("database.sqlite"));
+  read_only_database_ = std::make_unique<ads::Database>(
+      base_path_.AppendASCII("database.sqlite"));
 
   bat_ads_service_->Create(
       bat_ads_client_receiver_.BindNewEndpointAndPassRemote(),
@@ -1916,12 +1928,66 @@ ads::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
   return response;
 }
 
+ads::DBCommandResponsePtr RunReadOnlyDBTransactionOnTaskRunner(
+    ads::DBTransactionPtr transaction,
+    ads::Database* database) {
+  DCHECK(database);
+
+  auto response = ads::DBCommandResponse::New();
+
+  if (!database) {
+    response->status = ads::DBCommandResponse::Status::RESPONSE_ERROR;
+  } else {
+    database->RunReadOnlyTransaction(std::move(transaction), response.get());
+  }
+
+  return response;
+}
+
+AdsServiceImpl::PendingDBRead::PendingDBRead() = default;
+
+AdsServiceImpl::PendingDBRead::PendingDBRead(PendingDBRead&& other) = default;
+
+AdsServiceImpl::PendingDBRead& AdsServiceImpl::PendingDBRead::operator=(
+    PendingDBRead&& other) = default;
+
+AdsServiceImpl::PendingDBRead::~PendingDBRead() = default;
+
 void AdsServiceImpl::RunDBTransaction(ads::DBTransactionPtr transaction,
                                       ads::RunDBTransactionCallback callback) {
+  DCHECK(transaction);
+
+  if (ads::Database::IsReadOnlyTransaction(*transaction)) {
+    if (last_committed_db_write_id_ == last_posted_db_write_id_) {
+      RunReadOnlyDBTransaction(std::move(transaction), std::move(callback));
+      return;
+    }
+
+    PendingDBRead read;
+    read.write_id = last_posted_db_write_id_;
+    read.transaction = std::move(transaction);
+    read.callback = std::move(callback);
+    pending_db_reads_.push_back(std::move(read));
+    return;
+  }
+
+  const uint64_t write_id = ++last_posted_db_write_id_;
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RunDBTransactionOnFileTaskRunner,
                      base::Passed(std::move(transaction)), database_.get()),
+      base::BindOnce(&AdsServiceImpl::OnRunDBWriteTransaction, AsWeakPtr(),
+                     write_id, std::move(callback)));
+}
+
+void AdsServiceImpl::RunReadOnlyDBTransaction(
+    ads::DBTransactionPtr transaction,
+    ads::RunDBTransactionCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      db_read_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&RunReadOnlyDBTransactionOnTaskRunner,
+                     base::Passed(std::move(transaction)),
+                     read_only_database_.get()),
       base::BindOnce(&AdsServiceImpl::OnRunDBTransaction, AsWeakPtr(),
                      std::move(callback)));
 }
@@ -1931,6 +1997,26 @@ void AdsServiceImpl::OnRunDBTransaction(ads::RunDBTransactionCallback callback,
   callback(std::move(response));
 }
 
+void AdsServiceImpl::OnRunDBWriteTransaction(
+    const uint64_t write_id,
+    ads::RunDBTransactionCallback callback,
+    ads::DBCommandResponsePtr response) {
+  DCHECK_EQ(last_committed_db_write_id_ + 1, write_id);
+  last_committed_db_write_id_ = write_id;
+
+  // The write has committed, or failed, on the read-write connection, so
+  // snapshots taken from now on see it
+  while (!pending_db_reads_.empty() &&
+         pending_db_reads_.front().write_id <= write_id) {
+    PendingDBRead read = std::move(pending_db_reads_.front());
+    pending_db_reads_.pop_front();
+    RunReadOnlyDBTransaction(std::move(read.transaction),
+                             std::move(read.callback));
+  }
+
+  OnRunDBTransaction(std::move(callback), std::move(response));
+}
+
 void AdsServiceImpl::OnAdRewardsChanged() {
   for (AdsServiceObserver& observer : observers_) {
     observer.OnAdRewardsChanged();
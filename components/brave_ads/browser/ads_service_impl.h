@@ -268,6 +268,11 @@ class AdsServiceImpl : public AdsService,
 
   void OnRunDBTransaction(ads::RunDBTransactionCallback callback,
                           ads::DBCommandResponsePtr response);
+  void OnRunDBWriteTransaction(const uint64_t write_id,
+                               ads::RunDBTransactionCallback callback,
+                               ads::DBCommandResponsePtr response);
+  void RunReadOnlyDBTransaction(ads::DBTransactionPtr transaction,
+                                ads::RunDBTransactionCallback callback);
 
   void MigratePrefs();
   bool MigratePrefs(const int source_version,
@@ -394,6 +399,29 @@ class AdsServiceImpl : public AdsService,
 
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
+  // Read-only database transactions are served from a WAL snapshot on their
+  // own sequence so that catalog writes on |file_task_runner_| don't block ad
+  // serving
+  const scoped_refptr<base::SequencedTaskRunner> db_read_task_runner_;
+
+  // Writes are numbered in the order they are posted to |file_task_runner_|,
+  // which is also the order in which they commit. A read has to see the
+  // writes requested before it, so it waits for the last of them to commit
+  // before it takes its snapshot. Writes requested after it don't hold it up
+  struct PendingDBRead {
+    PendingDBRead();
+    PendingDBRead(PendingDBRead&& other);
+    PendingDBRead& operator=(PendingDBRead&& other);
+    ~PendingDBRead();
+
+    uint64_t write_id = 0;
+    ads::DBTransactionPtr transaction;
+    ads::RunDBTransactionCallback callback;
+  };
+  uint64_t last_posted_db_write_id_ = 0;
+  uint64_t last_committed_db_write_id_ = 0;
+  std::deque<PendingDBRead> pending_db_reads_;
+
   const base::FilePath base_path_;
 
   std::map<std::string, std::unique_ptr<base::OneShotTimer>>
@@ -404,6 +432,7 @@ class AdsServiceImpl : public AdsService,
   base::OneShotTimer onboarding_timer_;
 
   std::unique_ptr<ads::Database> database_;
+  std::unique_ptr<ads::Database> read_only_database_;
 
   ui::IdleState last_idle_state_;
   int last_idle_time_;
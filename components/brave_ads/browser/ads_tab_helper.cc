@@ -8,6 +8,8 @@
 #include <memory>
 #include <utility>
 
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -28,6 +30,83 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Collects the text of the page for text classification. Unlike innerText,
+// reading the value of text nodes does not force a synchronous layout. Only
+// the first |kMaxScanLength| characters are scanned, and if the page has more
+// than |kMaxTextLength| characters of text, evenly spaced samples of it are
+// returned, so the cost of extraction and the size of the message sent to the
+// browser are bounded however long the page is.
+//
+// Elements hidden with the hidden attribute or an inline display: none are
+// skipped. Elements hidden by style sheets are still collected, as telling
+// them apart would need the computed style of every element.
+constexpr char kExtractPageTextScript[] = R"((function() {
+  const kMaxTextLength = 16384;
+  const kMaxScanLength = 4 * kMaxTextLength;
+  const kSampleCount = 8;
+  const kIgnoredElements = new Set([
+    'SCRIPT', 'STYLE', 'NOSCRIPT', 'TEMPLATE', 'SVG', 'CANVAS', 'IFRAME',
+    'OBJECT', 'TEXTAREA', 'SELECT'
+  ]);
+
+  const body = document.body;
+  if (!body) {
+    return '';
+  }
+
+  const walker = document.createTreeWalker(body,
+      NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+        acceptNode: (node) => {
+          if (node.nodeType === Node.TEXT_NODE) {
+            return NodeFilter.FILTER_ACCEPT;
+          }
+          if (kIgnoredElements.has(node.nodeName.toUpperCase()) ||
+              node.hidden || (node.style && node.style.display === 'none')) {
+            return NodeFilter.FILTER_REJECT;
+          }
+          return NodeFilter.FILTER_SKIP;
+        }
+      });
+
+  const chunks = [];
+  let length = 0;
+  while (length < kMaxScanLength && walker.nextNode()) {
+    const text = walker.currentNode.nodeValue.replace(/\s+/g, ' ').trim();
+    if (text) {
+      chunks.push(text);
+      length += text.length + 1;
+    }
+  }
+
+  const text = chunks.join(' ');
+  if (text.length <= kMaxTextLength) {
+    return text;
+  }
+
+  const sampleLength = Math.floor(kMaxTextLength / kSampleCount);
+  const stride = Math.floor(text.length / kSampleCount);
+  const samples = [];
+  for (let i = 0; i < kSampleCount; i++) {
+    let sample = text.substr(i * stride, sampleLength);
+    // Drop partial words at either end of the sample
+    if (i > 0) {
+      sample = sample.substr(sample.indexOf(' ') + 1);
+    }
+    const end = sample.lastIndexOf(' ');
+    samples.push(end > 0 ? sample.substr(0, end) : sample);
+  }
+  return samples.join(' ');
+})())";
+
+}  // namespace
+
+// static
+const char* AdsTabHelper::GetExtractPageTextScriptForTesting() {
+  return kExtractPageTextScript;
+}
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -79,19 +158,28 @@ void AdsTabHelper::RunIsolatedJavaScript(
   DCHECK(render_frame_host);
 
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document.body.innerText",
+      render_frame_host, kExtractPageTextScript,
       base::BindOnce(&AdsTabHelper::OnJavaScriptResult,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), base::TimeTicks::Now()));
 }
 
-void AdsTabHelper::OnJavaScriptResult(base::Value value) {
+void AdsTabHelper::OnJavaScriptResult(const base::TimeTicks start_time,
+                                      base::Value value) {
   if (!IsAdsEnabled()) {
     return;
   }
 
-  DCHECK(value.is_string());
-  std::string content;
-  value.GetAsString(&content);
+  if (!value.is_string()) {
+    return;
+  }
+
+  std::string content = std::move(value.GetString());
+
+  const base::TimeDelta elapsed_time = base::TimeTicks::Now() - start_time;
+  UMA_HISTOGRAM_TIMES("Brave.Ads.PageTextExtractionTime", elapsed_time);
+  UMA_HISTOGRAM_COUNTS_100000("Brave.Ads.PageTextSize", content.size());
+  VLOG(1) << "Extracted " << content.size() << " bytes of page text in "
+          << elapsed_time.InMilliseconds() << " ms";
 
   ads_service_->OnPageLoaded(tab_id_, page_transition_, has_user_gesture_,
                              redirect_chain_, content);
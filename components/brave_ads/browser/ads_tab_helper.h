@@ -13,6 +13,7 @@
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_id.h"
 #include "content/public/browser/media_player_id.h"
@@ -52,6 +53,8 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  static const char* GetExtractPageTextScriptForTesting();
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
@@ -61,7 +64,7 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptResult(base::Value value);
+  void OnJavaScriptResult(const base::TimeTicks start_time, base::Value value);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
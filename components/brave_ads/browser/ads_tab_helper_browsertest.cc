@@ -0,0 +1,142 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "brave/components/brave_ads/browser/ads_tab_helper.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_browser_tests --filter=BraveAdsTabHelperBrowserTest.*
+
+namespace {
+
+// Matches kMaxTextLength in the page text extraction script
+constexpr size_t kMaxTextLength = 16384;
+
+}  // namespace
+
+class BraveAdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    ui_test_utils::NavigateToURL(browser(), GURL("about:blank"));
+  }
+
+  content::WebContents* web_contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  void SetBodyHtml(const std::string& html) {
+    ASSERT_TRUE(content::ExecJs(
+        web_contents(), content::JsReplace("document.body.innerHTML = $1;",
+                                           html)));
+  }
+
+  // Adds |count| paragraphs holding the words "w00000", "w00001", ...
+  void AddWords(int count) {
+    ASSERT_TRUE(content::ExecJs(
+        web_contents(),
+        base::StringPrintf(
+            "for (let i = 0; i < %d; i++) {"
+            "  const p = document.createElement('p');"
+            "  p.textContent = 'w' + String(i).padStart(5, '0');"
+            "  document.body.appendChild(p);"
+            "}",
+            count)));
+  }
+
+  std::string ExtractPageText() {
+    return content::EvalJs(
+               web_contents(),
+               brave_ads::AdsTabHelper::GetExtractPageTextScriptForTesting())
+        .ExtractString();
+  }
+
+  // Returns the indices of the words added by AddWords, failing if the text
+  // holds anything else, such as a partial word
+  std::vector<int> GetWordIndices(const std::string& text) {
+    std::vector<int> indices;
+    for (const auto& word : base::SplitString(
+             text, " ", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL)) {
+      int index;
+      if (word.size() != 6 || word[0] != 'w' ||
+          !base::StringToInt(word.substr(1), &index)) {
+        ADD_FAILURE() << "Unexpected word: " << word;
+        continue;
+      }
+      indices.push_back(index);
+    }
+    return indices;
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(BraveAdsTabHelperBrowserTest, CollapsesWhitespace) {
+  SetBodyHtml("<h1> Title </h1>\n<p>Some\n\n  text</p><div><span>more"
+              "</span> <b>text</b></div>");
+
+  EXPECT_EQ("Title Some text more text", ExtractPageText());
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsTabHelperBrowserTest, SkipsHiddenText) {
+  SetBodyHtml(
+      "<p>visible</p>"
+      "<p hidden>hidden attribute</p>"
+      "<div style='display: none'><p>display none</p></div>"
+      "<script>const script = 'script';</script>"
+      "<style>p { color: black; }</style>"
+      "<noscript>noscript</noscript>"
+      "<textarea>textarea</textarea>"
+      "<p>also visible</p>");
+
+  EXPECT_EQ("visible also visible", ExtractPageText());
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsTabHelperBrowserTest, SamplesLongText) {
+  // 7 characters per word, so about twice kMaxTextLength, but less than the
+  // scan limit
+  const int kWordCount = 5000;
+  AddWords(kWordCount);
+
+  const std::string text = ExtractPageText();
+  EXPECT_LE(text.size(), kMaxTextLength);
+  EXPECT_TRUE(base::StartsWith(text, "w00000 ", base::CompareCase::SENSITIVE));
+
+  const std::vector<int> indices = GetWordIndices(text);
+  ASSERT_FALSE(indices.empty());
+  for (size_t i = 1; i < indices.size(); i++) {
+    EXPECT_LT(indices[i - 1], indices[i]);
+  }
+  // The last of the evenly spaced samples starts 7/8th into the text
+  EXPECT_GE(indices.back(), kWordCount * 7 / 8);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsTabHelperBrowserTest, StopsScanningLongText) {
+  // 7 characters per word, so more than twice the scan limit
+  const int kWordCount = 20000;
+  AddWords(kWordCount);
+
+  const std::string text = ExtractPageText();
+  EXPECT_LE(text.size(), kMaxTextLength);
+
+  const std::vector<int> indices = GetWordIndices(text);
+  ASSERT_FALSE(indices.empty());
+  EXPECT_EQ(0, indices.front());
+  // Only the first 4 * kMaxTextLength characters, less than half of the
+  // words, are scanned
+  EXPECT_LT(indices.back(), kWordCount / 2);
+}
@@ -9,6 +9,9 @@ if (chrome.braveShields) {
   chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
     actions.resourceBlocked(detail)
   })
+  chrome.braveShields.onBlockedResources.addListener((details: BlockDetails[]) => {
+    details.forEach((detail) => actions.resourceBlocked(detail))
+  })
 } else {
   console.log('chrome.braveShields not enabled')
 }
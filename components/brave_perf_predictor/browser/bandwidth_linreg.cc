@@ -5,74 +5,68 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 
-#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
-bool StandardiseFeatsNoOutliers(
-    std::array<double, standardise_feat_count>* features,
-    const std::array<double, standardise_feat_count>& means,
-    const std::array<double, standardise_feat_count>& scale) {
-  for (unsigned int i = 0; i < standardise_feat_count; i++) {
-    features->at(i) = (features->at(i) - means[i]) / scale[i];
-  }
-  for (unsigned int i = 0; i < standardise_feat_count; i++) {
-    if (features->at(i) > kOutlierThreshold ||
-        features->at(i) < -kOutlierThreshold) {
-      VLOG(2) << "Outlier feature " << feature_sequence.at(i) << " with value "
-              << features->at(i);
-      return true;
-    }
+// Keys point into the global |relevant_entities|
+using ThirdPartyFeatureIndexMap = base::flat_map<base::StringPiece, size_t>;
+
+ThirdPartyFeatureIndexMap BuildThirdPartyFeatureIndexMap() {
+  std::vector<std::pair<base::StringPiece, size_t>> indices;
+  indices.reserve(relevant_entities.size());
+  for (size_t i = 0; i < relevant_entities.size(); i++) {
+    indices.emplace_back(relevant_entities[i], kThirdPartyBlockedOffset + i);
   }
-  return false;
+  return ThirdPartyFeatureIndexMap(std::move(indices));
 }
 
 }  // namespace
 
-double LinregPredictVector(const std::array<double, feature_count>& features) {
-  // Standardise numeric features
-  std::array<double, standardise_feat_count> numeric_features;
-  std::copy(features.begin(), features.begin() + standardise_feat_count,
-            numeric_features.begin());
-  bool has_outliers = StandardiseFeatsNoOutliers(
-      &numeric_features, standardise_feat_means, standardise_feat_scale);
-  if (has_outliers) {
-    VLOG(2) << "Feature set has outliers, return 0";
-    return 0;
+base::Optional<size_t> GetThirdPartyBlockedFeatureIndex(
+    base::StringPiece entity_name) {
+  static const base::NoDestructor<ThirdPartyFeatureIndexMap> index_map(
+      BuildThirdPartyFeatureIndexMap());
+  const auto it = index_map->find(entity_name);
+  if (it == index_map->end())
+    return base::nullopt;
+  return it->second;
+}
+
+double LinregPredictVector(const FeatureVector& features) {
+  // Standardise numeric features and fold them into the prediction in a
+  // single pass, bailing out on the first outlier
+  double log_prediction = model_intercept;
+  for (size_t i = 0; i < standardise_feat_count; i++) {
+    const double standardised_feature =
+        (features[i] - standardise_feat_means[i]) / standardise_feat_scale[i];
+    if (standardised_feature > kOutlierThreshold ||
+        standardised_feature < -kOutlierThreshold) {
+      VLOG(2) << "Outlier feature " << feature_sequence[i] << " with value "
+              << standardised_feature;
+      VLOG(2) << "Feature set has outliers, return 0";
+      return 0;
+    }
+    log_prediction += standardised_feature * model_coefficients[i];
   }
 
-  // Create a new feature vector to include all features
-  std::array<double, feature_count> standardised_features;
-  std::move(numeric_features.begin(), numeric_features.end(),
-            standardised_features.begin());
-  // Just copy the rest of the features as-is
-  std::copy(features.begin() + standardise_feat_count, features.end(),
-            standardised_features.begin() + standardise_feat_count);
+  // The rest of the features are used as-is
+  log_prediction = std::inner_product(
+      features.begin() + standardise_feat_count, features.end(),
+      model_coefficients.begin() + standardise_feat_count, log_prediction);
 
-  // Calculate the prediction
-  double log_prediction = std::inner_product(
-      standardised_features.begin(), standardised_features.end(),
-      model_coefficients.begin(), model_intercept);
   // We know the target is log-scaled but care about the absolute value
   return std::pow(10, log_prediction);
 }
 
-double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
-  std::array<double, feature_count> feature_vector{};
-  for (unsigned int i = 0; i < feature_count; i++) {
-    auto it = features.find(feature_sequence.at(i));
-    if (it != features.end())
-      feature_vector[i] = it->second;
-  }
-  return LinregPredictVector(feature_vector);
-}
-
 }  // namespace brave_perf_predictor
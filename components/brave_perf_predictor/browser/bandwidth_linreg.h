@@ -6,10 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 
+#include <stddef.h>
+
+#include <array>
 #include <string>
-#include <vector>
+#include <tuple>
 
-#include "base/containers/flat_map.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,18 +22,55 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Positions of the features in the vector expected by |LinregPredictVector|.
+// These follow |feature_sequence| in bandwidth_linreg_parameters.h and need to
+// be updated for any change in the model.
+enum FeatureIndex : size_t {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+  // One "thirdParties.<entity>.blocked" feature per |relevant_entities| entry
+  kThirdPartyBlockedOffset,
+};
+
+static_assert(kThirdPartyBlockedOffset == standardise_feat_count,
+              "Numeric features must precede third party features");
+static_assert(kThirdPartyBlockedOffset +
+                      std::tuple_size<decltype(relevant_entities)>::value ==
+                  feature_count,
+              "Every feature must have an index");
+
+using FeatureVector = std::array<double, feature_count>;
+
+// Returns the index of the "blocked" feature for the named third party
+// entity, if the entity is relevant to the model.
+base::Optional<size_t> GetThirdPartyBlockedFeatureIndex(
+    base::StringPiece entity_name);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
-// the exact order expected by the predictor.
-double LinregPredictVector(const std::array<double, feature_count>& features);
-
-// Computes prediction based on key-value map of features.
-// It translates the map to a feature vector internally, and
-// it is the client's responsibility to ensure that all required
-// features are present and only the necessary features are provided.
-// The function uses 0 for any features not provided and ignores
-// any extra features.
-double LinregPredictNamed(const base::flat_map<std::string, double>& features);
+// the exact order expected by the predictor, see |FeatureIndex|.
+double LinregPredictVector(const FeatureVector& features);
 
 }  // namespace brave_perf_predictor
 
@@ -5,20 +5,19 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 
-#include "base/containers/flat_map.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
 
 TEST(BraveSavingsPredictorTest, FeatureArrayGetsPrediction) {
-  const std::array<double, feature_count> features{};
+  const FeatureVector features{};
   double result = LinregPredictVector(features);
   EXPECT_NE(result, 0);
 }
 
 TEST(BraveSavingsPredictorTest, HandlesSpecificVectorExample) {
   // This test needs to be updated for any change in the model
-  constexpr std::array<double, feature_count> sample = {
+  constexpr FeatureVector sample = {
       20, 129, 225, 142, 925,    5, 34662, 3,  317818,  9,  1702888,
       0,  0,   1,   324, 32,  238315, 9, 90131, 54, 2367498, 59, 2384138,
       0,  1,   0,   0,   0,   0,      0, 0,     0,  1,       0,  0,
@@ -43,63 +42,90 @@ TEST(BraveSavingsPredictorTest, HandlesSpecificVectorExample) {
             794);  // Equal on the order of thousands
 }
 
-TEST(BraveSavingsPredictorTest, HandlesEmptyFeatureset) {
-  const base::flat_map<std::string, double> features{};
-  const double result = LinregPredictNamed(features);
-  const std::array<double, feature_count> features_array{};
-  const double array_result = LinregPredictVector(features_array);
-  EXPECT_EQ(result, array_result);
-}
+TEST(BraveSavingsPredictorTest, FeatureIndicesMatchModel) {
+  // This test needs to be updated for any change in the model
+  EXPECT_EQ(feature_sequence[kAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kFirstMeaningfulPaint],
+            "metrics.firstMeaningfulPaint");
+  EXPECT_EQ(feature_sequence[kObservedDomContentLoaded],
+            "metrics.observedDomContentLoaded");
+  EXPECT_EQ(feature_sequence[kObservedFirstVisualChange],
+            "metrics.observedFirstVisualChange");
+  EXPECT_EQ(feature_sequence[kObservedLoad], "metrics.observedLoad");
+  EXPECT_EQ(feature_sequence[kDocumentRequestCount],
+            "resources.document.requestCount");
+  EXPECT_EQ(feature_sequence[kDocumentSize], "resources.document.size");
+  EXPECT_EQ(feature_sequence[kFontRequestCount], "resources.font.requestCount");
+  EXPECT_EQ(feature_sequence[kFontSize], "resources.font.size");
+  EXPECT_EQ(feature_sequence[kImageRequestCount],
+            "resources.image.requestCount");
+  EXPECT_EQ(feature_sequence[kImageSize], "resources.image.size");
+  EXPECT_EQ(feature_sequence[kMediaRequestCount],
+            "resources.media.requestCount");
+  EXPECT_EQ(feature_sequence[kMediaSize], "resources.media.size");
+  EXPECT_EQ(feature_sequence[kOtherRequestCount],
+            "resources.other.requestCount");
+  EXPECT_EQ(feature_sequence[kOtherSize], "resources.other.size");
+  EXPECT_EQ(feature_sequence[kScriptRequestCount],
+            "resources.script.requestCount");
+  EXPECT_EQ(feature_sequence[kScriptSize], "resources.script.size");
+  EXPECT_EQ(feature_sequence[kStylesheetRequestCount],
+            "resources.stylesheet.requestCount");
+  EXPECT_EQ(feature_sequence[kStylesheetSize], "resources.stylesheet.size");
+  EXPECT_EQ(feature_sequence[kThirdPartyRequestCount],
+            "resources.third-party.requestCount");
+  EXPECT_EQ(feature_sequence[kThirdPartySize], "resources.third-party.size");
+  EXPECT_EQ(feature_sequence[kTotalRequestCount],
+            "resources.total.requestCount");
+  EXPECT_EQ(feature_sequence[kTotalSize], "resources.total.size");
 
-TEST(BraveSavingsPredictorTest, HandlesCompleteFeatureset) {
-  base::flat_map<std::string, double> features;
-  for (unsigned int i = 0; i < feature_count; i++) {
-    features[feature_sequence.at(i)] = 0;
+  for (const auto& entity : relevant_entities) {
+    const auto index = GetThirdPartyBlockedFeatureIndex(entity);
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(feature_sequence[*index], "thirdParties." + entity + ".blocked");
   }
-  const double result = LinregPredictNamed(features);
-  const std::array<double, feature_count> array_features{};
-  const double array_result = LinregPredictVector(array_features);
-  EXPECT_EQ(result, array_result);
 }
 
-TEST(BraveSavingsPredictorTest, HandesSpecificFeaturemapExample) {
+TEST(BraveSavingsPredictorTest, IgnoresIrrelevantThirdParty) {
+  EXPECT_FALSE(GetThirdPartyBlockedFeatureIndex("Not A Third Party"));
+}
+
+TEST(BraveSavingsPredictorTest, HandlesSpecificIndexedExample) {
   // This test needs to be updated for any change in the model
   // Third-parties that are not detected are skipped
-  const base::flat_map<std::string, double> featuremap = {
-      {"thirdParties.Facebook.blocked", 1},
-      {"thirdParties.Google Tag Manager.blocked", 1},
-      {"thirdParties.YouTube.blocked", 1},
-      {"thirdParties.Snapchat.blocked", 1},
-      {"thirdParties.Instagram.blocked", 1},
-      {"thirdParties.AddThis.blocked", 1},
-      {"thirdParties.Micropat.blocked", 1},
-      {"thirdParties.Playbuzz.blocked", 1},
-      {"thirdParties.Po.st.blocked", 1},
-      {"adblockRequests", 20},
-      {"metrics.firstMeaningfulPaint", 129},
-      {"metrics.observedDomContentLoaded", 225},
-      {"metrics.observedFirstVisualChange", 142},
-      {"metrics.observedLoad", 925},
-      {"resources.document.requestCount", 5},
-      {"resources.document.size", 34662},
-      {"resources.font.requestCount", 3},
-      {"resources.font.size", 317818},
-      {"resources.image.requestCount", 9},
-      {"resources.image.size", 1702888},
-      {"resources.media.requestCount", 0},
-      {"resources.media.size", 0},
-      {"resources.other.requestCount", 1},
-      {"resources.other.size", 324},
-      {"resources.script.requestCount", 32},
-      {"resources.script.size", 238315},
-      {"resources.stylesheet.requestCount", 9},
-      {"resources.third-party.requestCount", 54},
-      {"resources.third-party.size", 2367498},
-      {"resources.stylesheet.size", 90131},
-      {"resources.total.requestCount", 59},
-      {"resources.total.size", 238413},
-  };
-  double result = LinregPredictNamed(featuremap);
+  FeatureVector features{};
+  for (const char* entity :
+       {"Facebook", "Google Tag Manager", "YouTube", "Snapchat", "Instagram",
+        "AddThis", "Micropat", "Playbuzz", "Po.st"}) {
+    const auto index = GetThirdPartyBlockedFeatureIndex(entity);
+    if (index.has_value())
+      features[*index] = 1;
+  }
+  features[kAdblockRequests] = 20;
+  features[kFirstMeaningfulPaint] = 129;
+  features[kObservedDomContentLoaded] = 225;
+  features[kObservedFirstVisualChange] = 142;
+  features[kObservedLoad] = 925;
+  features[kDocumentRequestCount] = 5;
+  features[kDocumentSize] = 34662;
+  features[kFontRequestCount] = 3;
+  features[kFontSize] = 317818;
+  features[kImageRequestCount] = 9;
+  features[kImageSize] = 1702888;
+  features[kMediaRequestCount] = 0;
+  features[kMediaSize] = 0;
+  features[kOtherRequestCount] = 1;
+  features[kOtherSize] = 324;
+  features[kScriptRequestCount] = 32;
+  features[kScriptSize] = 238315;
+  features[kStylesheetRequestCount] = 9;
+  features[kStylesheetSize] = 90131;
+  features[kThirdPartyRequestCount] = 54;
+  features[kThirdPartySize] = 2367498;
+  features[kTotalRequestCount] = 59;
+  features[kTotalSize] = 238413;
+
+  const double result = LinregPredictVector(features);
   EXPECT_EQ(static_cast<int>(result / 1000),
             794);  // Equal on the order of thousands
 }
@@ -5,8 +5,6 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
-#include <iostream>
-
 #include "base/logging.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
@@ -15,6 +13,44 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+static_assert(kDocumentSize == kDocumentRequestCount + 1 &&
+                  kStylesheetSize == kStylesheetRequestCount + 1 &&
+                  kScriptSize == kScriptRequestCount + 1 &&
+                  kImageSize == kImageRequestCount + 1 &&
+                  kFontSize == kFontRequestCount + 1 &&
+                  kMediaSize == kMediaRequestCount + 1 &&
+                  kOtherSize == kOtherRequestCount + 1,
+              "Size features must follow request count features");
+
+// Returns the request count feature index for the resource type. The
+// matching size feature immediately follows it.
+size_t GetRequestCountFeatureIndex(
+    const network::mojom::RequestDestination destination) {
+  switch (destination) {
+    case network::mojom::RequestDestination::kDocument:
+    case network::mojom::RequestDestination::kIframe:
+      return kDocumentRequestCount;
+    case network::mojom::RequestDestination::kStyle:
+      return kStylesheetRequestCount;
+    case network::mojom::RequestDestination::kScript:
+      return kScriptRequestCount;
+    case network::mojom::RequestDestination::kImage:
+      return kImageRequestCount;
+    case network::mojom::RequestDestination::kFont:
+      return kFontRequestCount;
+    case network::mojom::RequestDestination::kAudio:
+    case network::mojom::RequestDestination::kTrack:
+    case network::mojom::RequestDestination::kVideo:
+      return kMediaRequestCount;
+    default:
+      return kOtherRequestCount;
+  }
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
     : tp_registry_(registry) {}
@@ -25,34 +61,37 @@ void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
+    features_[kFirstMeaningfulPaint] =
         timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
+    features_[kObservedDomContentLoaded] =
         timing.document_timing->dom_content_loaded_event_start.value()
             .InMillisecondsF();
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
+    features_[kObservedFirstVisualChange] =
         timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
+    features_[kObservedLoad] =
         timing.document_timing->load_event_start.value().InMillisecondsF();
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  features_[kAdblockRequests] += 1;
 
   if (tp_registry_) {
     const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    if (!tp_name.has_value())
+      return;
+    const auto feature_index = GetThirdPartyBlockedFeatureIndex(*tp_name);
+    if (feature_index.has_value())
+      features_[*feature_index] = 1;
   }
 }
 
@@ -65,7 +104,9 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
       !main_frame_url.SchemeIsHTTPOrHTTPS()) {
     return;
   }
-  main_frame_url_ = main_frame_url;
+  // Avoid copying the URL for every subresource of the same page
+  if (main_frame_url_ != main_frame_url)
+    main_frame_url_ = main_frame_url;
 
   const bool is_third_party =
       !net::registry_controlled_domains::SameDomainOrHost(
@@ -73,47 +114,18 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    features_[kThirdPartyRequestCount] += 1;
+    features_[kThirdPartySize] += resource_load_info.raw_body_bytes;
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
-  switch (resource_load_info.request_destination) {
-    case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
-      break;
-    case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
-      break;
-    case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
-      break;
-    case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
-      break;
-    case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
-      break;
-    case network::mojom::RequestDestination::kAudio:
-    case network::mojom::RequestDestination::kTrack:
-    case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
-      break;
-    default:
-      resource_type = "other";
-      break;
-  }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  features_[kTotalRequestCount] += 1;
+  features_[kTotalSize] += resource_load_info.raw_body_bytes;
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+
+  const size_t request_count_index =
+      GetRequestCountFeatureIndex(resource_load_info.request_destination);
+  features_[request_count_index] += 1;
+  features_[request_count_index + 1] += resource_load_info.raw_body_bytes;
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,37 +133,37 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (features_[kAdblockRequests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on features:";
+    for (size_t i = 0; i < features_.size(); i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
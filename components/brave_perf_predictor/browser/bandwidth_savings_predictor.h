@@ -8,8 +8,8 @@
 
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -61,10 +61,15 @@ class BandwidthSavingsPredictor {
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
                            FeaturiseResourceLoading);
+  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, ResetClearsFeatures);
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Dense model input, indexed by |FeatureIndex|. Kept as a fixed-size array
+  // so that page load callbacks don't allocate.
+  FeatureVector features_{};
+  // Not a model feature, used to sanity check the prediction
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
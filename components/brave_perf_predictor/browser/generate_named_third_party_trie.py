@@ -0,0 +1,192 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2021 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""
+Compiles the Third Party Web entities list into a reversed-label trie, emitted
+as a C++ header with constant data for NamedThirdPartyTrie. Only entities
+relevant to the bandwidth prediction model are kept.
+
+The layout must match NamedThirdPartyTrieStorage in named_third_party_trie.cc.
+
+Usage:
+    generate_named_third_party_trie.py --entities entities.json \
+        --parameters bandwidth_linreg_parameters.h --output trie_data.h
+"""
+
+from __future__ import unicode_literals
+
+import argparse
+import io
+import json
+import re
+import sys
+
+NO_ENTITY = -1
+CONFLICTING_ENTITIES = -2
+
+# The JSON parser returns unicode strings on Python 2
+try:
+  TEXT_TYPE = unicode
+except NameError:
+  TEXT_TYPE = str
+
+HEADER_TEMPLATE = """\
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// This file is generated by generate_named_third_party_trie.py, do not edit.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_DATA_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_DATA_H_
+
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_perf_predictor/browser/named_third_party_trie.h"
+
+namespace brave_perf_predictor {{
+
+constexpr NamedThirdPartyTrieNode kNamedThirdPartyTrieNodes[] = {{
+{nodes}
+}};
+
+constexpr char kNamedThirdPartyTrieLabels[] =
+{labels};
+
+constexpr base::StringPiece kNamedThirdPartyEntityNames[] = {{
+{entity_names}
+}};
+
+}}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_DATA_H_
+"""
+
+
+class Node(object):
+  def __init__(self):
+    self.children = {}
+    self.entity = NO_ENTITY
+    self.subtree_entity = NO_ENTITY
+
+
+def parse_relevant_entities(parameters_path):
+  with io.open(parameters_path, encoding='utf-8') as f:
+    parameters = f.read()
+  match = re.search(r'relevant_entities\s*\{(.*?)\};', parameters, re.DOTALL)
+  if not match:
+    raise ValueError('relevant_entities not found in ' + parameters_path)
+  return set(re.findall(r'"((?:[^"\\]|\\.)*)"', match.group(1)))
+
+
+def compute_subtree_entity(node):
+  result = node.entity
+  for label in sorted(node.children):
+    child_entity = compute_subtree_entity(node.children[label])
+    if child_entity == NO_ENTITY or child_entity == result:
+      continue
+    result = child_entity if result == NO_ENTITY else CONFLICTING_ENTITIES
+  node.subtree_entity = (NO_ENTITY if result == CONFLICTING_ENTITIES
+                         else result)
+  return result
+
+
+def build_trie(entities, relevant_entities):
+  root = Node()
+  entity_names = []
+  entity_ids = {}
+
+  for entity in entities:
+    name = entity.get('name')
+    if not name or name not in relevant_entities:
+      continue
+    domains = entity.get('domains')
+    if not isinstance(domains, list):
+      continue
+
+    if name not in entity_ids:
+      entity_ids[name] = len(entity_names)
+      entity_names.append(name)
+    entity_id = entity_ids[name]
+
+    for domain in domains:
+      if not isinstance(domain, TEXT_TYPE):
+        continue
+      labels = [label for label in domain.lower().split('.') if label]
+      if not labels:
+        continue
+      node = root
+      for label in reversed(labels):
+        node = node.children.setdefault(label, Node())
+      # Keep the first entity for duplicate domains
+      if node.entity == NO_ENTITY:
+        node.entity = entity_id
+
+  compute_subtree_entity(root)
+
+  # Flatten breadth-first, so that siblings are contiguous
+  order = [root]
+  nodes = [[0, 0, 0, 0, root.entity, root.subtree_entity]]
+  labels = []
+  labels_size = 0
+  i = 0
+  while i < len(order):
+    node = order[i]
+    nodes[i][2] = len(nodes)
+    nodes[i][3] = len(node.children)
+    for label in sorted(node.children):
+      child = node.children[label]
+      order.append(child)
+      nodes.append([labels_size, len(label), 0, 0, child.entity,
+                    child.subtree_entity])
+      labels.append(label)
+      labels_size += len(label)
+    i += 1
+
+  return nodes, ''.join(labels), entity_names
+
+
+def to_cpp_string(value):
+  return '"' + value.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def format_labels(labels, width=76):
+  if not labels:
+    return '    ""'
+  return '\n'.join('    ' + to_cpp_string(labels[i:i + width])
+                   for i in range(0, len(labels), width))
+
+
+def main(args):
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--entities', required=True,
+                      help='Path to the Third Party Web entities JSON.')
+  parser.add_argument('--parameters', required=True,
+                      help='Path to bandwidth_linreg_parameters.h.')
+  parser.add_argument('--output', required=True,
+                      help='Path to the generated header.')
+  options = parser.parse_args(args)
+
+  with io.open(options.entities, encoding='utf-8') as f:
+    entities = json.load(f)
+  relevant_entities = parse_relevant_entities(options.parameters)
+
+  nodes, labels, entity_names = build_trie(entities, relevant_entities)
+
+  with io.open(options.output, 'w', encoding='utf-8') as f:
+    f.write(HEADER_TEMPLATE.format(
+        nodes='\n'.join('    {%d, %d, %d, %d, %d, %d},' % tuple(node)
+                        for node in nodes),
+        labels=format_labels(labels),
+        entity_names='\n'.join('    ' + to_cpp_string(name) + ','
+                               for name in entity_names)))
+
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
@@ -5,42 +5,35 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "base/bind.h"
-#include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
-#include "base/metrics/histogram_macros.h"
-#include "base/strings/string_piece.h"
-#include "base/strings/string_util.h"
-#include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
-#include "components/grit/brave_components_resources.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "ui/base/resource/resource_bundle.h"
-#include "url/gurl.h"
+#include "url/third_party/mozilla/url_parse.h"
+#include "url/url_util.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
-
+std::unique_ptr<NamedThirdPartyTrieStorage> ParseMappings(
+    const base::StringPiece entities,
+    bool discard_irrelevant) {
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return {};
+    return nullptr;
   }
 
   // Collect the mappings
+  std::vector<std::pair<std::string, std::vector<std::string>>>
+      entity_domains;
   for (auto& entity : document->GetList()) {
     const std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
@@ -49,52 +42,45 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
       VLOG(3) << "Irrelevant entity " << *entity_name;
       continue;
     }
-    const auto* entity_domains = entity.FindListPath("domains");
-    if (!entity_domains)
+    const auto* domains = entity.FindListPath("domains");
+    if (!domains)
       continue;
 
-    for (auto& entity_domain_it : entity_domains->GetList()) {
-      if (!entity_domain_it.is_string()) {
+    std::vector<std::string> domain_list;
+    for (auto& domain : domains->GetList()) {
+      if (!domain.is_string()) {
         continue;
       }
-      const base::StringPiece entity_domain(entity_domain_it.GetString());
-
-      const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
-      if (!inserted.second) {
-        VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
-      }
-      auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-          entity_domain,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
-        // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
-      } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
-      }
+      domain_list.push_back(domain.GetString());
     }
+    entity_domains.emplace_back(*entity_name, std::move(domain_list));
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  return std::make_unique<NamedThirdPartyTrieStorage>(entity_domains);
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
-  // TODO(AndriusA): insert trace event here
-  SCOPED_UMA_HISTOGRAM_TIMER(
-      "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
-  auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
-  std::string data_resource =
-      resource_bundle.LoadDataResourceString(resource_id);
-  // Parse resource, discarding irrelevant entities
-  return ParseMappings(data_resource, true);
+// Returns the length of the registrable domain (eTLD+1) at the end of |host|,
+// or 0 if there is none.
+size_t GetRootDomainLength(const base::StringPiece host) {
+  if (url::HostIsIPAddress(host))
+    return 0;
+
+  const size_t registry_length =
+      net::registry_controlled_domains::GetCanonicalHostRegistryLength(
+          host, net::registry_controlled_domains::EXCLUDE_UNKNOWN_REGISTRIES,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  // Hosts which are themselves a registry, or which have no known registry,
+  // have no root domain
+  if (registry_length == 0 || registry_length == std::string::npos ||
+      registry_length + 1 >= host.size()) {
+    return 0;
+  }
+
+  const size_t registry_dot = host.size() - registry_length - 1;
+  const size_t root_domain_dot = host.rfind('.', registry_dot - 1);
+  const size_t root_domain_start =
+      root_domain_dot == base::StringPiece::npos ? 0 : root_domain_dot + 1;
+  return host.size() - root_domain_start;
 }
 
 }  // namespace
@@ -102,53 +88,42 @@ ParseFromResource(int resource_id) {
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  trie_ = {};
+  trie_storage_.reset();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  trie_storage_ = ParseMappings(entities, discard_irrelevant);
+  if (!trie_storage_)
+    return false;
+  trie_ = trie_storage_->trie();
+  if (trie_.empty())
     return false;
 
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
-  initialized_ = true;
-}
-
-base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+base::Optional<base::StringPiece> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
     return base::nullopt;
   }
 
-  const GURL url(request_url);
-  if (!url.is_valid())
+  // Extract the host in place rather than building a GURL, blocked request
+  // URLs are already canonical
+  url::Parsed parsed;
+  url::ParseStandardURL(request_url.data(), request_url.size(), &parsed);
+  if (!parsed.scheme.is_nonempty() || !parsed.host.is_nonempty())
     return base::nullopt;
+  const base::StringPiece host =
+      request_url.substr(parsed.host.begin, parsed.host.len);
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
-
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
-  }
-
-  return base::nullopt;
+  const base::StringPiece entity =
+      trie_.Find(host, GetRootDomainLength(host));
+  if (entity.empty())
+    return base::nullopt;
+  return entity;
 }
 
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
@@ -156,11 +131,10 @@ NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
 void NamedThirdPartyRegistry::InitializeDefault() {
-  base::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&ParseFromResource, IDR_THIRD_PARTY_ENTITIES),
-      base::BindOnce(&NamedThirdPartyRegistry::UpdateMappings,
-                     weak_factory_.GetWeakPtr()));
+  trie_storage_.reset();
+  trie_ = GetDefaultNamedThirdPartyTrie();
+  VLOG(2) << "Loaded " << trie_.nodes.size() << " third party domain labels";
+  initialized_ = true;
 }
 
 }  // namespace brave_perf_predictor
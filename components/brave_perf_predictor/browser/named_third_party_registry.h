@@ -6,12 +6,11 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
-#include <string>
-#include <tuple>
+#include <memory>
 
-#include "base/containers/flat_map.h"
-#include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_perf_predictor/browser/named_third_party_trie.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace brave_perf_predictor {
@@ -31,23 +30,21 @@ class NamedThirdPartyRegistry : public KeyedService {
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
-  // Default initialization - asynchronously load from bundled resource
+  // Default initialization - use the mappings compiled from the bundled
+  // resource at build time
   void InitializeDefault();
-  base::Optional<std::string> GetThirdParty(
-      const base::StringPiece domain) const;
+  // Returns the entity for the (canonical) URL. The returned string piece
+  // stays valid until mappings are reloaded. Doesn't allocate.
+  base::Optional<base::StringPiece> GetThirdParty(
+      const base::StringPiece request_url) const;
 
  private:
   bool IsInitialized() const { return initialized_; }
-  void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
-
-  base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
+  NamedThirdPartyTrie trie_;
+  // Only set for mappings loaded at runtime, |trie_| points into it
+  std::unique_ptr<NamedThirdPartyTrieStorage> trie_storage_;
 };
 
 }  // namespace brave_perf_predictor
@@ -7,7 +7,9 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -119,4 +121,57 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, HandlesRootDomainClashTest) {
+  NamedThirdPartyRegistry registry;
+  ASSERT_TRUE(registry.LoadMappings(R"([
+      {"name": "First", "domains": ["a.shared.com", "first.com"]},
+      {"name": "Second", "domains": ["b.shared.com"]}
+  ])",
+                                    false));
+
+  EXPECT_EQ(registry.GetThirdParty("https://a.shared.com/x.js").value(),
+            "First");
+  EXPECT_EQ(registry.GetThirdParty("https://b.shared.com/x.js").value(),
+            "Second");
+  EXPECT_EQ(registry.GetThirdParty("https://cdn.first.com/x.js").value(),
+            "First");
+  // Neither entity owns the shared root domain
+  EXPECT_FALSE(registry.GetThirdParty("https://c.shared.com/x.js"));
+  EXPECT_FALSE(registry.GetThirdParty("https://shared.com/x.js"));
+}
+
+TEST(NamedThirdPartyRegistryTest, HandlesIPAddressTest) {
+  NamedThirdPartyRegistry registry;
+  registry.InitializeDefault();
+
+  auto entity = registry.GetThirdParty("https://23.62.3.183/");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Facebook");
+  EXPECT_FALSE(registry.GetThirdParty("https://1.2.3.183/"));
+}
+
+TEST(NamedThirdPartyRegistryTest, DefaultMatchesParsedDatasetTest) {
+  NamedThirdPartyRegistry parsed_registry;
+  ASSERT_TRUE(parsed_registry.LoadMappings(LoadFile(), true));
+  NamedThirdPartyRegistry default_registry;
+  default_registry.InitializeDefault();
+
+  base::Optional<base::Value> document = base::JSONReader::Read(LoadFile());
+  ASSERT_TRUE(document && document->is_list());
+  for (const auto& entity : document->GetList()) {
+    const auto* domains = entity.FindListPath("domains");
+    if (!domains)
+      continue;
+    for (const auto& domain : domains->GetList()) {
+      for (const std::string& url :
+           {"https://" + domain.GetString() + "/",
+            "https://sub." + domain.GetString() + "/"}) {
+        EXPECT_EQ(parsed_registry.GetThirdParty(url),
+                  default_registry.GetThirdParty(url))
+            << url;
+      }
+    }
+  }
+}
+
 }  // namespace brave_perf_predictor
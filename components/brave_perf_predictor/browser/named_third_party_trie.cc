@@ -0,0 +1,164 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_perf_predictor/browser/named_third_party_trie.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#include "base/check_op.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "brave/components/brave_perf_predictor/browser/named_third_party_trie_data.h"
+
+namespace brave_perf_predictor {
+
+namespace {
+
+constexpr int32_t kConflictingEntities = -2;
+
+struct BuilderNode {
+  std::map<std::string, std::unique_ptr<BuilderNode>> children;
+  int32_t entity = kNoThirdPartyEntity;
+  int32_t subtree_entity = kNoThirdPartyEntity;
+};
+
+int32_t ComputeSubtreeEntity(BuilderNode* node) {
+  int32_t result = node->entity;
+  for (auto& child : node->children) {
+    const int32_t child_entity = ComputeSubtreeEntity(child.second.get());
+    if (child_entity == kNoThirdPartyEntity || child_entity == result)
+      continue;
+    result = result == kNoThirdPartyEntity ? child_entity
+                                           : kConflictingEntities;
+  }
+  node->subtree_entity =
+      result == kConflictingEntities ? kNoThirdPartyEntity : result;
+  return result;
+}
+
+}  // namespace
+
+base::StringPiece NamedThirdPartyTrie::Find(base::StringPiece host,
+                                            size_t root_domain_length) const {
+  if (empty() || host.empty())
+    return base::StringPiece();
+
+  const size_t root_domain_start =
+      root_domain_length > 0 && root_domain_length <= host.size()
+          ? host.size() - root_domain_length
+          : base::StringPiece::npos;
+
+  int32_t root_domain_entity = kNoThirdPartyEntity;
+  const NamedThirdPartyTrieNode* node = &nodes[0];
+  size_t label_end = host.size();
+  while (true) {
+    const size_t dot = host.rfind('.', label_end - 1);
+    const size_t label_start = dot == base::StringPiece::npos ? 0 : dot + 1;
+    const base::StringPiece label =
+        host.substr(label_start, label_end - label_start);
+
+    const auto children =
+        nodes.subspan(node->first_child, node->child_count);
+    const auto child = std::lower_bound(
+        children.begin(), children.end(), label,
+        [this](const NamedThirdPartyTrieNode& child, base::StringPiece label) {
+          return labels.substr(child.label_offset, child.label_length) < label;
+        });
+    if (child == children.end() ||
+        labels.substr(child->label_offset, child->label_length) != label) {
+      break;
+    }
+    node = &*child;
+
+    if (label_start == root_domain_start)
+      root_domain_entity = node->subtree_entity;
+
+    if (label_start == 0) {
+      if (node->entity != kNoThirdPartyEntity)
+        return entity_names[node->entity];
+      break;
+    }
+
+    label_end = dot;
+    if (label_end == 0)
+      break;
+  }
+
+  if (root_domain_entity != kNoThirdPartyEntity)
+    return entity_names[root_domain_entity];
+  return base::StringPiece();
+}
+
+NamedThirdPartyTrieStorage::NamedThirdPartyTrieStorage(
+    const std::vector<std::pair<std::string, std::vector<std::string>>>&
+        entity_domains) {
+  BuilderNode root;
+  std::map<std::string, int32_t> entity_ids;
+
+  for (const auto& entry : entity_domains) {
+    const auto inserted = entity_ids.emplace(
+        entry.first, static_cast<int32_t>(entity_names_.size()));
+    if (inserted.second)
+      entity_names_.push_back(entry.first);
+    const int32_t entity_id = inserted.first->second;
+
+    for (const auto& domain : entry.second) {
+      std::vector<std::string> domain_labels =
+          base::SplitString(base::ToLowerASCII(domain), ".",
+                            base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+      if (domain_labels.empty())
+        continue;
+
+      BuilderNode* node = &root;
+      for (auto it = domain_labels.rbegin(); it != domain_labels.rend();
+           ++it) {
+        auto& child = node->children[*it];
+        if (!child)
+          child = std::make_unique<BuilderNode>();
+        node = child.get();
+      }
+      // Keep the first entity for duplicate domains
+      if (node->entity == kNoThirdPartyEntity)
+        node->entity = entity_id;
+    }
+  }
+
+  ComputeSubtreeEntity(&root);
+
+  // Flatten breadth-first, so that siblings are contiguous
+  std::vector<const BuilderNode*> order = {&root};
+  nodes_.push_back({0, 0, 0, 0, root.entity, root.subtree_entity});
+  for (size_t i = 0; i < order.size(); i++) {
+    const BuilderNode* node = order[i];
+    nodes_[i].first_child = static_cast<uint32_t>(nodes_.size());
+    nodes_[i].child_count = static_cast<uint32_t>(node->children.size());
+    for (const auto& child : node->children) {
+      order.push_back(child.second.get());
+      nodes_.push_back({static_cast<uint32_t>(labels_.size()),
+                        static_cast<uint32_t>(child.first.size()), 0, 0,
+                        child.second->entity, child.second->subtree_entity});
+      labels_.append(child.first);
+    }
+  }
+  DCHECK_EQ(order.size(), nodes_.size());
+
+  for (const auto& entity_name : entity_names_)
+    entity_name_pieces_.push_back(entity_name);
+}
+
+NamedThirdPartyTrieStorage::~NamedThirdPartyTrieStorage() = default;
+
+NamedThirdPartyTrie NamedThirdPartyTrieStorage::trie() const {
+  return {nodes_, labels_, entity_name_pieces_};
+}
+
+NamedThirdPartyTrie GetDefaultNamedThirdPartyTrie() {
+  return {kNamedThirdPartyTrieNodes, kNamedThirdPartyTrieLabels,
+          kNamedThirdPartyEntityNames};
+}
+
+}  // namespace brave_perf_predictor
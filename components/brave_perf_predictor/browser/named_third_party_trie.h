@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_perf_predictor {
+
+constexpr int32_t kNoThirdPartyEntity = -1;
+
+// A node of a trie keyed by domain labels in reverse order, i.e. "m.fb.com"
+// is stored as "com" -> "fb" -> "m". The layout is shared with the generated
+// data (see generate_named_third_party_trie.py) and must be kept in sync.
+struct NamedThirdPartyTrieNode {
+  // Label of the edge leading to this node, as a slice of |labels|.
+  uint32_t label_offset;
+  uint32_t label_length;
+  // Children are stored contiguously and sorted by label.
+  uint32_t first_child;
+  uint32_t child_count;
+  // Entity owning exactly this domain.
+  int32_t entity;
+  // Entity owning every domain in this subtree, if there is only one. Used
+  // for matching on the root domain of unlisted hosts.
+  int32_t subtree_entity;
+};
+
+// Read-only view over a reversed-label trie. Lookups don't allocate.
+struct NamedThirdPartyTrie {
+  // Returns the entity name for |host|, or an empty string piece. An exact
+  // match wins; otherwise |host| is matched on its trailing
+  // |root_domain_length| characters, as long as all known domains under that
+  // root domain belong to the same entity. Pass 0 to skip root domain
+  // matching.
+  base::StringPiece Find(base::StringPiece host,
+                         size_t root_domain_length) const;
+
+  bool empty() const { return nodes.size() <= 1; }
+
+  // Node 0 is the root.
+  base::span<const NamedThirdPartyTrieNode> nodes;
+  base::StringPiece labels;
+  base::span<const base::StringPiece> entity_names;
+};
+
+// Owns a trie built at runtime from entity to domains mappings.
+class NamedThirdPartyTrieStorage {
+ public:
+  // Entities and domains are interned in the order they are given, so this
+  // produces the same layout as the generated data.
+  explicit NamedThirdPartyTrieStorage(
+      const std::vector<std::pair<std::string, std::vector<std::string>>>&
+          entity_domains);
+  ~NamedThirdPartyTrieStorage();
+
+  NamedThirdPartyTrieStorage(const NamedThirdPartyTrieStorage&) = delete;
+  NamedThirdPartyTrieStorage& operator=(const NamedThirdPartyTrieStorage&) =
+      delete;
+
+  NamedThirdPartyTrie trie() const;
+
+ private:
+  std::vector<NamedThirdPartyTrieNode> nodes_;
+  std::string labels_;
+  std::vector<std::string> entity_names_;
+  std::vector<base::StringPiece> entity_name_pieces_;
+};
+
+// Trie compiled from the bundled Third Party Web entities at build time,
+// limited to entities relevant to the bandwidth prediction model.
+NamedThirdPartyTrie GetDefaultNamedThirdPartyTrie();
+
+}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_TRIE_H_
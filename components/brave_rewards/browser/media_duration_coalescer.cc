@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/media_duration_coalescer.h"
+
+#include "base/bind.h"
+
+namespace brave_rewards {
+
+MediaDurationCoalescer::PendingDurations::PendingDurations() = default;
+MediaDurationCoalescer::PendingDurations::~PendingDurations() = default;
+MediaDurationCoalescer::PendingDurations::PendingDurations(
+    PendingDurations&&) = default;
+MediaDurationCoalescer::PendingDurations&
+MediaDurationCoalescer::PendingDurations::operator=(PendingDurations&&) =
+    default;
+
+MediaDurationCoalescer::MediaDurationCoalescer(base::TimeDelta flush_interval,
+                                               FlushCallback callback)
+    : flush_interval_(flush_interval), callback_(std::move(callback)) {}
+
+MediaDurationCoalescer::~MediaDurationCoalescer() = default;
+
+void MediaDurationCoalescer::AddDuration(uint64_t window_id,
+                                         const std::string& publisher_key,
+                                         uint64_t duration,
+                                         bool first_visit) {
+  const Key key(window_id, publisher_key);
+  auto it = pending_.find(key);
+
+  // Only the first chunk of a batch may start a visit, so a new visit hands
+  // over what was collected for the previous one.
+  if (it != pending_.end() && first_visit) {
+    FlushEntry(it->first, &it->second);
+    pending_.erase(it);
+    it = pending_.end();
+  }
+
+  if (it == pending_.end()) {
+    it = pending_.emplace(key, PendingDurations()).first;
+    it->second.first_visit = first_visit;
+  }
+  it->second.durations.push_back(duration);
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, flush_interval_,
+                       base::BindOnce(&MediaDurationCoalescer::Flush,
+                                      base::Unretained(this)));
+  }
+}
+
+void MediaDurationCoalescer::Flush() {
+  flush_timer_.Stop();
+
+  std::map<Key, PendingDurations> pending;
+  pending.swap(pending_);
+  for (auto& entry : pending) {
+    FlushEntry(entry.first, &entry.second);
+  }
+}
+
+void MediaDurationCoalescer::FlushWindow(uint64_t window_id) {
+  auto it = pending_.lower_bound(Key(window_id, std::string()));
+  while (it != pending_.end() && it->first.first == window_id) {
+    FlushEntry(it->first, &it->second);
+    it = pending_.erase(it);
+  }
+
+  if (pending_.empty())
+    flush_timer_.Stop();
+}
+
+void MediaDurationCoalescer::FlushEntry(const Key& key,
+                                        PendingDurations* pending) {
+  if (pending->durations.empty())
+    return;
+
+  callback_.Run(key.first, key.second, pending->durations,
+                pending->first_visit);
+}
+
+}  // namespace brave_rewards
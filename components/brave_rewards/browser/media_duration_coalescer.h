@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_DURATION_COALESCER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_DURATION_COALESCER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace brave_rewards {
+
+// Collects media durations reported for a tab and publisher and hands them
+// over in batches at a fixed cadence, so that a long streaming session does
+// not turn every few seconds of playback into a separate ledger update.
+// Durations are kept as separate chunks because the ledger scores every
+// chunk on its own.
+class MediaDurationCoalescer {
+ public:
+  using FlushCallback =
+      base::RepeatingCallback<void(uint64_t window_id,
+                                   const std::string& publisher_key,
+                                   const std::vector<uint64_t>& durations,
+                                   bool first_visit)>;
+
+  MediaDurationCoalescer(base::TimeDelta flush_interval,
+                         FlushCallback callback);
+  ~MediaDurationCoalescer();
+
+  MediaDurationCoalescer(const MediaDurationCoalescer&) = delete;
+  MediaDurationCoalescer& operator=(const MediaDurationCoalescer&) = delete;
+
+  void AddDuration(uint64_t window_id,
+                   const std::string& publisher_key,
+                   uint64_t duration,
+                   bool first_visit);
+
+  // Hands over everything collected so far.
+  void Flush();
+
+  // Hands over what was collected for |window_id|, e.g. when the tab closes.
+  void FlushWindow(uint64_t window_id);
+
+  bool empty() const { return pending_.empty(); }
+
+ private:
+  struct PendingDurations {
+    PendingDurations();
+    ~PendingDurations();
+    PendingDurations(PendingDurations&&);
+    PendingDurations& operator=(PendingDurations&&);
+
+    std::vector<uint64_t> durations;
+    bool first_visit = false;
+  };
+
+  using Key = std::pair<uint64_t, std::string>;
+
+  void FlushEntry(const Key& key, PendingDurations* pending);
+
+  const base::TimeDelta flush_interval_;
+  FlushCallback callback_;
+  std::map<Key, PendingDurations> pending_;
+  base::OneShotTimer flush_timer_;
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_DURATION_COALESCER_H_
@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/media_duration_coalescer.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=MediaDurationCoalescerTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+constexpr base::TimeDelta kFlushInterval = base::TimeDelta::FromSeconds(30);
+
+struct FlushedDurations {
+  uint64_t window_id;
+  std::string publisher_key;
+  std::vector<uint64_t> durations;
+  bool first_visit;
+};
+
+}  // namespace
+
+class MediaDurationCoalescerTest : public testing::Test {
+ protected:
+  MediaDurationCoalescerTest()
+      : coalescer_(kFlushInterval,
+                   base::BindRepeating(&MediaDurationCoalescerTest::OnFlush,
+                                       base::Unretained(this))) {}
+
+  void OnFlush(uint64_t window_id,
+               const std::string& publisher_key,
+               const std::vector<uint64_t>& durations,
+               bool first_visit) {
+    flushed_.push_back({window_id, publisher_key, durations, first_visit});
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  MediaDurationCoalescer coalescer_;
+  std::vector<FlushedDurations> flushed_;
+};
+
+TEST_F(MediaDurationCoalescerTest, FlushesAtFixedCadence) {
+  // Arrange
+  coalescer_.AddDuration(1, "youtube#channel:1", 5, true);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  coalescer_.AddDuration(1, "youtube#channel:1", 10, false);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  coalescer_.AddDuration(1, "youtube#channel:1", 10, false);
+  EXPECT_TRUE(flushed_.empty());
+
+  // Act
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+
+  // Assert
+  ASSERT_EQ(1u, flushed_.size());
+  EXPECT_EQ(1u, flushed_[0].window_id);
+  EXPECT_EQ("youtube#channel:1", flushed_[0].publisher_key);
+  EXPECT_EQ((std::vector<uint64_t>{5, 10, 10}), flushed_[0].durations);
+  EXPECT_TRUE(flushed_[0].first_visit);
+  EXPECT_TRUE(coalescer_.empty());
+}
+
+TEST_F(MediaDurationCoalescerTest, KeepsTabsAndPublishersApart) {
+  // Arrange
+  coalescer_.AddDuration(1, "twitch#author:a", 5, false);
+  coalescer_.AddDuration(2, "twitch#author:a", 6, false);
+  coalescer_.AddDuration(1, "twitch#author:b", 7, false);
+
+  // Act
+  coalescer_.Flush();
+
+  // Assert
+  ASSERT_EQ(3u, flushed_.size());
+  for (const auto& flushed : flushed_) {
+    EXPECT_EQ(1u, flushed.durations.size());
+  }
+}
+
+TEST_F(MediaDurationCoalescerTest, NewVisitFlushesPreviousOne) {
+  // Arrange
+  coalescer_.AddDuration(1, "vimeo#channel:1", 5, true);
+  coalescer_.AddDuration(1, "vimeo#channel:1", 10, false);
+
+  // Act
+  coalescer_.AddDuration(1, "vimeo#channel:1", 3, true);
+
+  // Assert
+  ASSERT_EQ(1u, flushed_.size());
+  EXPECT_EQ((std::vector<uint64_t>{5, 10}), flushed_[0].durations);
+  EXPECT_TRUE(flushed_[0].first_visit);
+
+  coalescer_.Flush();
+  ASSERT_EQ(2u, flushed_.size());
+  EXPECT_EQ((std::vector<uint64_t>{3}), flushed_[1].durations);
+  EXPECT_TRUE(flushed_[1].first_visit);
+}
+
+TEST_F(MediaDurationCoalescerTest, FlushesSingleWindow) {
+  // Arrange
+  coalescer_.AddDuration(1, "youtube#channel:1", 5, false);
+  coalescer_.AddDuration(2, "youtube#channel:1", 6, false);
+  coalescer_.AddDuration(2, "youtube#channel:2", 7, false);
+  coalescer_.AddDuration(3, "youtube#channel:1", 8, false);
+
+  // Act
+  coalescer_.FlushWindow(2);
+
+  // Assert
+  ASSERT_EQ(2u, flushed_.size());
+  EXPECT_EQ(2u, flushed_[0].window_id);
+  EXPECT_EQ(2u, flushed_[1].window_id);
+  EXPECT_FALSE(coalescer_.empty());
+}
+
+}  // namespace brave_rewards
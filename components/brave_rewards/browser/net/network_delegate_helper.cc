@@ -43,10 +43,10 @@ content::WebContents* GetWebContents(
 }
 
 void DispatchOnUI(
-    const std::string post_data,
-    const GURL url,
-    const GURL first_party_url,
-    const std::string referrer,
+    const std::string& post_data,
+    const GURL& url,
+    const GURL& first_party_url,
+    const std::string& referrer,
     int render_process_id,
     int render_frame_id,
     int frame_tree_node_id) {
@@ -23,12 +23,14 @@
 #include "base/json/json_string_value_serializer.h"
 #include "base/json/json_writer.h"
 #include "base/logging.h"
+#include "base/run_loop.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
@@ -41,7 +43,6 @@
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "brave/components/brave_ads/browser/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/android_util.h"
-#include "brave/components/brave_rewards/browser/file_util.h"
 #include "brave/components/brave_rewards/browser/logging.h"
 #include "brave/components/brave_rewards/browser/logging_util.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
@@ -96,8 +97,13 @@ static const unsigned int kRetriesCountOnNetworkChange = 1;
 namespace {
 
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kTailDiagnosticLogToNumLines = 20000;
-const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+const int64_t kDiagnosticLogSegmentSize = 1024 * 1024;
+const size_t kDiagnosticLogMaxSegments = 10;
+const size_t kDiagnosticLogFlushSize = 64 * 1024;
+constexpr base::TimeDelta kDiagnosticLogFlushDelay =
+    base::TimeDelta::FromSeconds(1);
+constexpr base::TimeDelta kFlushPublisherActivityTimeout =
+    base::TimeDelta::FromSeconds(3);
 const char pref_prefix[] = "brave.rewards";
 
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
@@ -260,6 +266,21 @@ std::string GetPrefPath(const std::string& name) {
   return base::StringPrintf("%s.%s", pref_prefix, name.c_str());
 }
 
+// Media durations reported by Greaselion are handed to the ledger in batches
+// of this interval.
+constexpr base::TimeDelta kMediaDurationFlushInterval =
+    base::TimeDelta::FromSeconds(30);
+
+std::string DecodePostData(const std::string& post_data) {
+  url::RawCanonOutputW<1024> canonOutput;
+  url::DecodeURLEscapeSequences(post_data.c_str(),
+                                post_data.length(),
+                                url::DecodeURLMode::kUTF8OrIsomorphic,
+                                &canonOutput);
+  return base::UTF16ToUTF8(base::StringPiece16(canonOutput.data(),
+                                               canonOutput.length()));
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -302,12 +323,20 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
           {base::ThreadPool(), base::MayBlock(),
            base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
-      diagnostic_log_path_(profile_->GetPath().Append(kDiagnosticLogPath)),
+      diagnostic_log_(
+          new SegmentedLog(profile_->GetPath().Append(kDiagnosticLogPath),
+                           kDiagnosticLogSegmentSize,
+                           kDiagnosticLogMaxSegments),
+          base::OnTaskRunnerDeleter(file_task_runner_)),
       ledger_state_path_(profile_->GetPath().Append(kLedger_state)),
       publisher_state_path_(profile_->GetPath().Append(kPublisher_state)),
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
+      media_duration_coalescer_(
+          kMediaDurationFlushInterval,
+          base::BindRepeating(&RewardsServiceImpl::OnMediaDurationsCoalesced,
+                              base::Unretained(this))),
       next_timer_id_(0) {
   // Set up the rewards data source
   content::URLDataSource::Add(profile_,
@@ -656,6 +685,7 @@ void RewardsServiceImpl::OnUnload(SessionID tab_id) {
     return;
   }
 
+  media_duration_coalescer_.FlushWindow(tab_id.id());
   bat_ledger_->OnUnload(tab_id.id(), GetCurrentTimestamp());
 }
 
@@ -704,17 +734,27 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
     return;
   }
 
-  std::string output;
-  url::RawCanonOutputW<1024> canonOutput;
-  url::DecodeURLEscapeSequences(post_data.c_str(),
-                                post_data.length(),
-                                url::DecodeURLMode::kUTF8OrIsomorphic,
-                                &canonOutput);
-  output = base::UTF16ToUTF8(base::StringPiece16(canonOutput.data(),
-                                                 canonOutput.length()));
+  // Beacons can be large, decode them off the UI thread
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&DecodePostData, post_data),
+      base::BindOnce(&RewardsServiceImpl::OnPostDataDecoded,
+                     AsWeakPtr(),
+                     tab_id,
+                     url,
+                     first_party_url,
+                     referrer));
+}
 
-  if (output.empty())
+void RewardsServiceImpl::OnPostDataDecoded(SessionID tab_id,
+                                           const GURL& url,
+                                           const GURL& first_party_url,
+                                           const GURL& referrer,
+                                           const std::string& output) {
+  if (!Connected() || output.empty()) {
     return;
+  }
 
   ledger::type::VisitDataPtr data = ledger::type::VisitData::New();
   data->path = url.spec(),
@@ -807,10 +847,35 @@ void RewardsServiceImpl::Shutdown() {
   }
   url_loaders_.clear();
 
+  // Coalesced durations are sent ahead of the flush on the same pipe, and
+  // the ledger only replies to the flush once they are recorded.
+  media_duration_coalescer_.Flush();
+  FlushPublisherActivity();
+  FlushDiagnosticLog();
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
 
+void RewardsServiceImpl::FlushPublisherActivity() {
+  if (!Connected()) {
+    return;
+  }
+
+  // The ledger keeps publisher activity in memory and only writes it back
+  // after a delay. Its database transactions are run by us, so keep
+  // running tasks until the write back is done, but don't hold up shutdown
+  // for long if the ledger process doesn't reply.
+  base::RunLoop run_loop;
+  bat_ledger_->FlushPublisherActivity(base::BindOnce(
+      [](base::OnceClosure quit_closure, const ledger::type::Result) {
+        std::move(quit_closure).Run();
+      },
+      run_loop.QuitClosure()));
+  base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, run_loop.QuitClosure(), kFlushPublisherActivityTimeout);
+  run_loop.Run();
+}
+
 void RewardsServiceImpl::OnLedgerInitialized(
     StartProcessCallback callback,
     const ledger::type::Result result) {
@@ -1370,6 +1435,7 @@ void RewardsServiceImpl::OnStopLedgerForCompleteReset(
     SuccessCallback callback,
     const ledger::type::Result result) {
   profile_->GetPrefs()->ClearPrefsWithPrefixSilently(pref_prefix);
+  DiscardDiagnosticLogBuffer();
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
@@ -1384,18 +1450,14 @@ void RewardsServiceImpl::OnStopLedgerForCompleteReset(
 }
 
 bool RewardsServiceImpl::ResetOnFilesTaskRunner() {
-  // Close any open files before deleting them (required on Windows)
-  diagnostic_log_.Close();
-
   const std::vector<base::FilePath> paths = {
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
-    diagnostic_log_path_,
     publisher_list_path_,
   };
 
-  bool res = true;
+  bool res = diagnostic_log_->Delete();
   for (size_t i = 0; i < paths.size(); i++) {
     if (!base::DeletePathRecursively(paths[i])) {
       res = false;
@@ -1926,13 +1988,29 @@ void RewardsServiceImpl::UpdateMediaDuration(
     return;
   }
 
-  bat_ledger_->UpdateMediaDuration(
+  media_duration_coalescer_.AddDuration(
       window_id,
       publisher_key,
       duration,
       first_visit);
 }
 
+void RewardsServiceImpl::OnMediaDurationsCoalesced(
+    const uint64_t window_id,
+    const std::string& publisher_key,
+    const std::vector<uint64_t>& durations,
+    const bool first_visit) {
+  if (!Connected()) {
+    return;
+  }
+
+  bat_ledger_->UpdateMediaDurations(
+      window_id,
+      publisher_key,
+      durations,
+      first_visit);
+}
+
 void RewardsServiceImpl::GetPublisherInfo(
     const std::string& publisher_key,
     GetPublisherInfoCallback callback) {
@@ -2242,32 +2320,6 @@ void RewardsServiceImpl::ShowNotificationTipsPaid(bool ac_enabled) {
       "rewards_notification_tips_processed");
 }
 
-bool RewardsServiceImpl::MaybeTailDiagnosticLog(
-    const int num_lines) {
-  if (!diagnostic_log_.IsValid()) {
-    return false;
-  }
-
-  static bool first_run = true;
-
-  const int64_t length = diagnostic_log_.GetLength();
-  if (length == -1) {
-    return false;
-  }
-
-  if (!first_run && length <= kDiagnosticLogMaxFileSize) {
-    return true;
-  }
-
-  first_run = false;
-
-  if (!TailFile(&diagnostic_log_, num_lines)) {
-    return false;
-  }
-
-  return true;
-}
-
 void RewardsServiceImpl::DiagnosticLog(
     const std::string& file,
     const int line,
@@ -2285,52 +2337,42 @@ void RewardsServiceImpl::DiagnosticLog(
     return;
   }
 
-  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner,
-          base::Unretained(this),
-          diagnostic_log_path_,
-          kTailDiagnosticLogToNumLines,
-          file,
-          line,
-          verbose_level,
-          message),
-      base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
-          AsWeakPtr()));
-}
+  diagnostic_log_buffer_ += FriendlyFormatLogEntry(
+      base::Time::Now(), file, line, verbose_level, message);
 
-bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& log_path,
-    const int num_lines,
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
-  if (!InitializeLog(&diagnostic_log_, log_path)) {
-    VLOG(0) << "Failed to initialize diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
-
-    return false;
+  if (diagnostic_log_buffer_.size() >= kDiagnosticLogFlushSize) {
+    FlushDiagnosticLog();
+    return;
   }
 
-  const base::Time time = base::Time::Now();
-
-  const std::string log_entry =
-      FriendlyFormatLogEntry(time, file, line, verbose_level, message);
+  if (!diagnostic_log_flush_timer_.IsRunning()) {
+    diagnostic_log_flush_timer_.Start(FROM_HERE, kDiagnosticLogFlushDelay,
+        base::BindOnce(&RewardsServiceImpl::FlushDiagnosticLog,
+            base::Unretained(this)));
+  }
+}
 
-  if (!WriteToLog(&diagnostic_log_, log_entry)) {
-    VLOG(0) << "Failed to write to diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
+void RewardsServiceImpl::FlushDiagnosticLog() {
+  diagnostic_log_flush_timer_.Stop();
 
-    return false;
+  if (diagnostic_log_buffer_.empty()) {
+    return;
   }
 
-  if (!MaybeTailDiagnosticLog(num_lines)) {
-    VLOG(0) << "Failed to vacuum diagnostic log";
+  std::string log_entries;
+  log_entries.swap(diagnostic_log_buffer_);
 
-    return false;
-  }
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&SegmentedLog::Write,
+          base::Unretained(diagnostic_log_.get()),
+          std::move(log_entries)),
+      base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
+          AsWeakPtr()));
+}
 
-  return true;
+void RewardsServiceImpl::DiscardDiagnosticLogBuffer() {
+  diagnostic_log_flush_timer_.Stop();
+  diagnostic_log_buffer_.clear();
 }
 
 void RewardsServiceImpl::OnWriteToLogOnFileTaskRunner(
@@ -2341,10 +2383,12 @@ void RewardsServiceImpl::OnWriteToLogOnFileTaskRunner(
 void RewardsServiceImpl::LoadDiagnosticLog(
       const int num_lines,
       LoadDiagnosticLogCallback callback) {
+  // Make sure the most recent entries are included
+  FlushDiagnosticLog();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
-          diagnostic_log_path_,
           num_lines),
       base::BindOnce(&RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner,
           AsWeakPtr(),
@@ -2352,18 +2396,9 @@ void RewardsServiceImpl::LoadDiagnosticLog(
 }
 
 std::string RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& path,
     const int num_lines) {
-  if (!base::PathExists(path)) {
-    return "";
-  }
-
   std::string value;
-  if (!TailFileAsString(&diagnostic_log_, num_lines, &value)) {
-    return base::StringPrintf("ERROR: %s",
-        GetLastFileError(&diagnostic_log_).c_str());
-  }
-
+  diagnostic_log_->ReadLastLines(num_lines, &value);
   return value;
 }
 
@@ -2375,24 +2410,18 @@ void RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner(
 
 void RewardsServiceImpl::ClearDiagnosticLog(
     ClearDiagnosticLogCallback callback) {
+  DiscardDiagnosticLogBuffer();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner,
-          base::Unretained(this),
-          diagnostic_log_path_),
+          base::Unretained(this)),
       base::BindOnce(&RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner,
           AsWeakPtr(),
           std::move(callback)));
 }
 
-bool RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& path) {
-  if (!base::PathExists(path)) {
-    return true;
-  }
-
-  diagnostic_log_.Close();
-
-  return base::DeleteFile(path);
+bool RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner() {
+  return diagnostic_log_->Delete();
 }
 
 void RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner(
@@ -2666,9 +2695,7 @@ void RewardsServiceImpl::PublisherListNormalized(
   for (auto& observer : observers_) {
     ledger::type::PublisherInfoList new_list;
     for (const auto& publisher : list) {
-      if (publisher->percent >= 1) {
-        new_list.push_back(publisher->Clone());
-      }
+      new_list.push_back(publisher->Clone());
     }
     observer.OnPublisherListNormalized(this, std::move(new_list));
   }
@@ -3376,7 +3403,7 @@ void RewardsServiceImpl::WalletDisconnected(const std::string& wallet_type) {
 }
 
 void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
-  diagnostic_log_.Close();
+  DiscardDiagnosticLogBuffer();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
@@ -3390,7 +3417,7 @@ void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
 }
 
 bool RewardsServiceImpl::DeleteLogTaskRunner() {
-  return base::DeleteFile(diagnostic_log_path_);
+  return diagnostic_log_->Delete();
 }
 
 void RewardsServiceImpl::OnDeleteLog(
@@ -20,11 +20,15 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
+#include "base/sequenced_task_runner.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
+#include "brave/components/brave_rewards/browser/media_duration_coalescer.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
+#include "brave/components/brave_rewards/browser/segmented_log.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
@@ -577,22 +581,17 @@ class RewardsServiceImpl : public RewardsService,
       SavePublisherInfoCallback callback,
       const ledger::type::Result result);
 
-  bool MaybeTailDiagnosticLog(
-      const int num_lines);
-
   void DiagnosticLog(
       const std::string& file,
       const int line,
       const int verbose_level,
       const std::string& message) override;
 
-  bool WriteToDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& log_path,
-      const int num_lines,
-      const std::string& file,
-      const int line,
-      const int verbose_level,
-      const std::string& message);
+  void FlushDiagnosticLog();
+
+  void FlushPublisherActivity();
+
+  void DiscardDiagnosticLogBuffer();
 
   void OnWriteToLogOnFileTaskRunner(
     const bool success);
@@ -602,7 +601,6 @@ class RewardsServiceImpl : public RewardsService,
       LoadDiagnosticLogCallback callback) override;
 
   std::string LoadDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& path,
       const int num_lines);
 
   void OnLoadDiagnosticLogOnFileTaskRunner(
@@ -613,8 +611,7 @@ class RewardsServiceImpl : public RewardsService,
 
   void CompleteReset(SuccessCallback callback) override;
 
-  bool ClearDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& path);
+  bool ClearDiagnosticLogOnFileTaskRunner();
 
   void OnClearDiagnosticLogOnFileTaskRunner(
       ClearDiagnosticLogCallback callback,
@@ -700,6 +697,19 @@ class RewardsServiceImpl : public RewardsService,
       const ledger::type::Result result,
       ledger::type::PublisherInfoPtr publisher);
 
+  void OnMediaDurationsCoalesced(
+      const uint64_t window_id,
+      const std::string& publisher_key,
+      const std::vector<uint64_t>& durations,
+      const bool first_visit);
+
+  void OnPostDataDecoded(
+      SessionID tab_id,
+      const GURL& url,
+      const GURL& first_party_url,
+      const GURL& referrer,
+      const std::string& output);
+
   void OnContributeUnverifiedPublishers(
       ledger::type::Result result,
       const std::string& publisher_key,
@@ -783,8 +793,11 @@ class RewardsServiceImpl : public RewardsService,
   mojo::AssociatedRemote<bat_ledger::mojom::BatLedger> bat_ledger_;
   mojo::Remote<bat_ledger::mojom::BatLedgerService> bat_ledger_service_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
-  const base::FilePath diagnostic_log_path_;
-  base::File diagnostic_log_;
+  // Lives on |file_task_runner_|, entries are buffered in
+  // |diagnostic_log_buffer_| until they are flushed
+  std::unique_ptr<SegmentedLog, base::OnTaskRunnerDeleter> diagnostic_log_;
+  std::string diagnostic_log_buffer_;
+  base::OneShotTimer diagnostic_log_flush_timer_;
   const base::FilePath ledger_state_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
@@ -796,6 +809,7 @@ class RewardsServiceImpl : public RewardsService,
   std::unique_ptr<RewardsServicePrivateObserver> private_observer_;
 
   std::unique_ptr<base::OneShotEvent> ready_;
+  MediaDurationCoalescer media_duration_coalescer_;
   base::flat_set<network::SimpleURLLoader*> url_loaders_;
   std::map<std::string, BitmapFetcherService::RequestId>
       current_media_fetchers_;
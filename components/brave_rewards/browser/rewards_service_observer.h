@@ -59,6 +59,8 @@ class RewardsServiceObserver : public base::CheckedObserver {
       brave_rewards::RewardsService* rewards_service,
       const ledger::type::Result result) {}
 
+  // |list| only holds the publishers whose percentage changed, including the
+  // ones which dropped to zero.
   virtual void OnPublisherListNormalized(
       RewardsService* rewards_service,
       ledger::type::PublisherInfoList list) {}
@@ -0,0 +1,226 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/segmented_log.h"
+
+#include <algorithm>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_rewards/browser/file_util.h"
+#include "brave/components/brave_rewards/browser/logging_util.h"
+
+namespace brave_rewards {
+
+namespace {
+
+const size_t kDividerLength = 80;
+
+}  // namespace
+
+SegmentedLog::SegmentedLog(
+    const base::FilePath& path,
+    int64_t segment_size,
+    size_t max_segments)
+    : path_(path),
+      segment_size_(segment_size),
+      max_segments_(max_segments) {
+  DCHECK_GT(segment_size_, 0);
+  DCHECK_GT(max_segments_, 0u);
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+SegmentedLog::~SegmentedLog() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+base::FilePath SegmentedLog::GetSegmentPath(const uint64_t index) const {
+  return path_.AddExtensionASCII(base::NumberToString(index));
+}
+
+std::vector<uint64_t> SegmentedLog::FindSegments() const {
+  const base::FilePath::StringType prefix =
+      path_.BaseName().value() + FILE_PATH_LITERAL(".");
+
+  std::vector<uint64_t> segments;
+  base::FileEnumerator enumerator(path_.DirName(), false,
+      base::FileEnumerator::FILES, prefix + FILE_PATH_LITERAL("*"));
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    const base::FilePath suffix(path.BaseName().value().substr(prefix.size()));
+    uint64_t index;
+    if (base::StringToUint64(suffix.MaybeAsASCII(), &index) && index > 0) {
+      segments.push_back(index);
+    }
+  }
+
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
+bool SegmentedLog::Initialize() {
+  if (initialized_) {
+    return true;
+  }
+
+  const std::vector<uint64_t> segments = FindSegments();
+  segments_.assign(segments.begin(), segments.end());
+
+  if (base::PathExists(path_)) {
+    // Keep the log written by previous versions as the oldest segment
+    if (segments_.empty() && base::Move(path_, GetSegmentPath(1))) {
+      segments_.push_back(1);
+    } else {
+      base::DeleteFile(path_);
+    }
+  }
+
+  if (segments_.empty()) {
+    if (!StartNewSegment()) {
+      return false;
+    }
+  } else {
+    if (!OpenSegment(segments_.back(), false)) {
+      return false;
+    }
+
+    WriteToLog(&segment_, std::string(kDividerLength, '-') + "\n");
+  }
+
+  initialized_ = true;
+  return true;
+}
+
+bool SegmentedLog::OpenSegment(const uint64_t index, const bool create) {
+  segment_.Close();
+
+  const uint32_t flags = create ? base::File::FLAG_CREATE_ALWAYS
+                                : base::File::FLAG_OPEN_ALWAYS;
+  segment_.Initialize(GetSegmentPath(index),
+      flags | base::File::FLAG_READ | base::File::FLAG_WRITE);
+  if (!segment_.IsValid()) {
+    VLOG(0) << "Failed to open diagnostic log segment: "
+        << GetLastFileError(&segment_);
+    return false;
+  }
+
+  segment_length_ = segment_.GetLength();
+  return segment_length_ != -1;
+}
+
+bool SegmentedLog::StartNewSegment() {
+  const uint64_t index = segments_.empty() ? 1 : segments_.back() + 1;
+  if (!OpenSegment(index, true)) {
+    return false;
+  }
+
+  segments_.push_back(index);
+
+  while (segments_.size() > max_segments_) {
+    base::DeleteFile(GetSegmentPath(segments_.front()));
+    segments_.pop_front();
+  }
+
+  return true;
+}
+
+bool SegmentedLog::Write(const std::string& log_entries) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (log_entries.empty()) {
+    return true;
+  }
+
+  if (!Initialize()) {
+    return false;
+  }
+
+  if (segment_length_ >= segment_size_ && !StartNewSegment()) {
+    return false;
+  }
+
+  if (!WriteToLog(&segment_, log_entries)) {
+    VLOG(0) << "Failed to write to diagnostic log: "
+        << GetLastFileError(&segment_);
+    return false;
+  }
+
+  segment_length_ += log_entries.size();
+  return true;
+}
+
+bool SegmentedLog::ReadLastLines(const int num_lines, std::string* value) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(value);
+
+  std::vector<base::FilePath> paths;
+  if (initialized_) {
+    for (const auto index : segments_) {
+      paths.push_back(GetSegmentPath(index));
+    }
+  } else {
+    if (base::PathExists(path_)) {
+      paths.push_back(path_);
+    }
+
+    for (const auto index : FindSegments()) {
+      paths.push_back(GetSegmentPath(index));
+    }
+  }
+
+  value->clear();
+
+  // Read the newest segments first and stop once enough lines were found
+  int remaining_lines = num_lines;
+  for (auto iter = paths.rbegin(); iter != paths.rend(); ++iter) {
+    base::File file(*iter, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!file.IsValid()) {
+      continue;
+    }
+
+    std::string segment_value;
+    if (!TailFileAsString(&file, remaining_lines, &segment_value)) {
+      *value = "ERROR: " + GetLastFileError(&file);
+      return false;
+    }
+
+    value->insert(0, segment_value);
+
+    if (num_lines == -1) {
+      continue;
+    }
+
+    remaining_lines -=
+        std::count(segment_value.begin(), segment_value.end(), '\n');
+    if (remaining_lines <= 0) {
+      break;
+    }
+  }
+
+  return true;
+}
+
+bool SegmentedLog::Delete() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Close the segment before deleting it (required on Windows)
+  segment_.Close();
+  segment_length_ = 0;
+  segments_.clear();
+  initialized_ = false;
+
+  bool success = base::DeleteFile(path_);
+  for (const auto index : FindSegments()) {
+    if (!base::DeleteFile(GetSegmentPath(index))) {
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+}  // namespace brave_rewards
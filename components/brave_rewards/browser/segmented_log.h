@@ -0,0 +1,72 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+
+namespace brave_rewards {
+
+// Keeps the Rewards diagnostic log as a series of segment files next to
+// |path| (e.g. Rewards.log.1, Rewards.log.2, ...). Entries are appended to the
+// newest segment until it reaches |segment_size|, then a new segment is
+// started. Once there are more than |max_segments| segments the oldest one is
+// deleted, so trimming the log never rewrites it. A log written by previous
+// versions to |path| itself is kept as the oldest segment.
+//
+// All methods block and must be called on the same sequence.
+class SegmentedLog {
+ public:
+  SegmentedLog(const base::FilePath& path,
+                int64_t segment_size,
+                size_t max_segments);
+  ~SegmentedLog();
+
+  SegmentedLog(const SegmentedLog&) = delete;
+  SegmentedLog& operator=(const SegmentedLog&) = delete;
+
+  // Appends |log_entries|, which should end with a newline.
+  bool Write(const std::string& log_entries);
+
+  // Returns the last |num_lines| lines of the log, or all of it if
+  // |num_lines| is -1.
+  bool ReadLastLines(const int num_lines, std::string* value);
+
+  // Deletes all segments.
+  bool Delete();
+
+  const base::FilePath& path() const { return path_; }
+
+ private:
+  base::FilePath GetSegmentPath(const uint64_t index) const;
+  std::vector<uint64_t> FindSegments() const;
+  bool Initialize();
+  bool OpenSegment(const uint64_t index, const bool create);
+  bool StartNewSegment();
+
+  const base::FilePath path_;
+  const int64_t segment_size_;
+  const size_t max_segments_;
+
+  bool initialized_ = false;
+  base::circular_deque<uint64_t> segments_;
+  base::File segment_;
+  int64_t segment_length_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
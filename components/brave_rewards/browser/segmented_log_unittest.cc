@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/segmented_log.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SegmentedLogTest.*
+
+namespace brave_rewards {
+
+class SegmentedLogTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+  }
+
+  base::FilePath GetSegmentPath(const int index) const {
+    return path_.AddExtensionASCII(base::NumberToString(index));
+  }
+
+  std::string ReadLastLines(SegmentedLog* log, const int num_lines) {
+    std::string value;
+    EXPECT_TRUE(log->ReadLastLines(num_lines, &value));
+    return value;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(SegmentedLogTest, ReadsLastLinesAcrossSegments) {
+  SegmentedLog log(path_, 7, 10);
+  for (int i = 0; i < 6; i++) {
+    ASSERT_TRUE(log.Write("line " + base::NumberToString(i) + "\n"));
+  }
+
+  // Every segment holds a single entry
+  EXPECT_TRUE(base::PathExists(GetSegmentPath(6)));
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(7)));
+
+  EXPECT_EQ("line 4\nline 5\n", ReadLastLines(&log, 2));
+  EXPECT_EQ("line 0\nline 1\nline 2\nline 3\nline 4\nline 5\n",
+            ReadLastLines(&log, -1));
+  EXPECT_EQ(ReadLastLines(&log, -1), ReadLastLines(&log, 100));
+}
+
+TEST_F(SegmentedLogTest, DeletesOldestSegments) {
+  SegmentedLog log(path_, 7, 3);
+  for (int i = 0; i < 5; i++) {
+    ASSERT_TRUE(log.Write("line " + base::NumberToString(i) + "\n"));
+  }
+
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(1)));
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(2)));
+  EXPECT_TRUE(base::PathExists(GetSegmentPath(3)));
+  EXPECT_EQ("line 2\nline 3\nline 4\n", ReadLastLines(&log, -1));
+}
+
+TEST_F(SegmentedLogTest, AppendsToNewestSegmentOnRestart) {
+  {
+    SegmentedLog log(path_, 1024, 10);
+    ASSERT_TRUE(log.Write("first\n"));
+  }
+
+  SegmentedLog log(path_, 1024, 10);
+  EXPECT_EQ("first\n", ReadLastLines(&log, -1));
+  ASSERT_TRUE(log.Write("second\n"));
+
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(2)));
+  EXPECT_EQ("second\n", ReadLastLines(&log, 1));
+  EXPECT_EQ(0u, ReadLastLines(&log, 3).find("first\n"));
+}
+
+TEST_F(SegmentedLogTest, KeepsLegacyLogAsOldestSegment) {
+  ASSERT_TRUE(base::WriteFile(path_, "legacy\n"));
+
+  SegmentedLog log(path_, 1024, 10);
+  EXPECT_EQ("legacy\n", ReadLastLines(&log, -1));
+
+  ASSERT_TRUE(log.Write("entry\n"));
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_TRUE(base::PathExists(GetSegmentPath(1)));
+  EXPECT_EQ("entry\n", ReadLastLines(&log, 1));
+  EXPECT_EQ(0u, ReadLastLines(&log, -1).find("legacy\n"));
+}
+
+TEST_F(SegmentedLogTest, Delete) {
+  ASSERT_TRUE(base::WriteFile(path_, "legacy\n"));
+  SegmentedLog log(path_, 7, 10);
+  ASSERT_TRUE(log.Write("line 0\n"));
+  ASSERT_TRUE(log.Write("line 1\n"));
+
+  EXPECT_TRUE(log.Delete());
+  EXPECT_TRUE(base::IsDirectoryEmpty(temp_dir_.GetPath()));
+  EXPECT_EQ("", ReadLastLines(&log, -1));
+
+  ASSERT_TRUE(log.Write("line 2\n"));
+  EXPECT_EQ("line 2\n", ReadLastLines(&log, -1));
+}
+
+}  // namespace brave_rewards
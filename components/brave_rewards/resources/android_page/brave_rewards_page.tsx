@@ -65,8 +65,12 @@ window.cr.define('brave_rewards', function () {
     getActions().onReconcileStamp(stamp)
   }
 
-  function contributeList (list: Rewards.Publisher[]) {
-    getActions().onContributeList(list)
+  function contributeListPage (page: Rewards.PublisherListPage) {
+    getActions().onContributeListPage(page)
+  }
+
+  function contributeListChanged (list: Rewards.Publisher[]) {
+    getActions().onContributeListChanged(list)
   }
 
   function excludedList (list: Rewards.ExcludedPublisher[]) {
@@ -168,7 +172,8 @@ window.cr.define('brave_rewards', function () {
     promotions,
     promotionFinish,
     reconcileStamp,
-    contributeList,
+    contributeListPage,
+    contributeListChanged,
     excludedList,
     balanceReport,
     contributionAmount,
@@ -268,6 +268,7 @@ export const rewardsPanelReducer: Reducer<RewardsExtension.State | undefined> =
         break
       }
 
+      // Only publishers whose percentage changed are listed
       for (const key in publishers) {
         let publisher = publishers[key]
         const updated = list.find((newPublisher: RewardsExtension.PublisherNormalized) =>
@@ -277,8 +278,6 @@ export const rewardsPanelReducer: Reducer<RewardsExtension.State | undefined> =
           publisher.status = updated.status
           publisher.percentage = updated.percentage
           publisher.excluded = false
-        } else {
-          publisher.percentage = 0
         }
       }
 
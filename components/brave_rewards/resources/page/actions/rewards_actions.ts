@@ -80,7 +80,11 @@ export const onReconcileStamp = (stamp: number) => action(types.ON_RECONCILE_STA
   stamp
 })
 
-export const onContributeList = (list: Rewards.Publisher[]) => action(types.ON_CONTRIBUTE_LIST, {
+export const onContributeListPage = (page: Rewards.PublisherListPage) => action(types.ON_CONTRIBUTE_LIST_PAGE, {
+  page
+})
+
+export const onContributeListChanged = (list: Rewards.Publisher[]) => action(types.ON_CONTRIBUTE_LIST_CHANGED, {
   list
 })
 
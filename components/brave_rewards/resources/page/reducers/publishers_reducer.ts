@@ -13,16 +13,71 @@ const publishersReducer: Reducer<Rewards.State | undefined> = (state: Rewards.St
   }
 
   switch (action.type) {
-    case types.ON_CONTRIBUTE_LIST:
+    case types.ON_CONTRIBUTE_LIST_PAGE: {
+      const page: Rewards.PublisherListPage = action.payload.page
+      if (!page || !page.publishers) {
+        break
+      }
+
       state = { ...state }
-      if (state.contributeLoad) {
-        state.firstLoad = false
+      if (page.cursor === 0) {
+        if (state.contributeLoad) {
+          state.firstLoad = false
+        } else {
+          state.contributeLoad = true
+        }
+
+        state.autoContributeList = page.publishers
       } else {
-        state.contributeLoad = true
+        // Publishers which changed while paging may already be listed
+        const listed: Record<string, boolean> = {}
+        state.autoContributeList.forEach((publisher: Rewards.Publisher) => {
+          listed[publisher.publisherKey] = true
+        })
+        state.autoContributeList = state.autoContributeList.concat(
+          page.publishers.filter((publisher: Rewards.Publisher) =>
+            !listed[publisher.publisherKey]))
       }
 
-      state.autoContributeList = action.payload.list
+      if (page.nextCursor !== undefined) {
+        chrome.send('brave_rewards.getContributionListPage', [page.nextCursor])
+      }
       break
+    }
+    case types.ON_CONTRIBUTE_LIST_CHANGED: {
+      const list: Rewards.Publisher[] = action.payload.list
+      if (!list || list.length === 0) {
+        break
+      }
+
+      const changed: Record<string, Rewards.Publisher> = {}
+      list.forEach((publisher: Rewards.Publisher) => {
+        changed[publisher.publisherKey] = publisher
+      })
+
+      const autoContributeList = state.autoContributeList.map((publisher: Rewards.Publisher) => {
+        const updated = changed[publisher.publisherKey]
+        if (!updated) {
+          return publisher
+        }
+        delete changed[publisher.publisherKey]
+        return updated
+      })
+      Object.keys(changed).forEach((key: string) => {
+        autoContributeList.push(changed[key])
+      })
+
+      state = { ...state }
+      state.autoContributeList = autoContributeList
+        .filter((publisher: Rewards.Publisher) => publisher.percentage >= 1)
+        .sort((a: Rewards.Publisher, b: Rewards.Publisher) => {
+          if (a.percentage !== b.percentage) {
+            return b.percentage - a.percentage
+          }
+          return a.publisherKey < b.publisherKey ? -1 : 1
+        })
+      break
+    }
     case types.ON_EXCLUDED_LIST: {
       if (!action.payload.list) {
         break
@@ -6,13 +6,13 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -20,98 +20,36 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
 using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
-std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
-  std::string filter_option = "";
-  switch (resource_type) {
-    // top level page
-    case blink::mojom::ResourceType::kMainFrame:
-      filter_option = "main_frame";
-      break;
-    // frame or iframe
-    case blink::mojom::ResourceType::kSubFrame:
-      filter_option = "sub_frame";
-      break;
-    // a CSS stylesheet
-    case blink::mojom::ResourceType::kStylesheet:
-      filter_option = "stylesheet";
-      break;
-    // an external script
-    case blink::mojom::ResourceType::kScript:
-      filter_option = "script";
-      break;
-    // an image (jpg/gif/png/etc)
-    case blink::mojom::ResourceType::kFavicon:
-    case blink::mojom::ResourceType::kImage:
-      filter_option = "image";
-      break;
-    // a font
-    case blink::mojom::ResourceType::kFontResource:
-      filter_option = "font";
-      break;
-    // an "other" subresource.
-    case blink::mojom::ResourceType::kSubResource:
-      filter_option = "other";
-      break;
-    // an object (or embed) tag for a plugin.
-    case blink::mojom::ResourceType::kObject:
-      filter_option = "object";
-      break;
-    // a media resource.
-    case blink::mojom::ResourceType::kMedia:
-      filter_option = "media";
-      break;
-    // a XMLHttpRequest
-    case blink::mojom::ResourceType::kXhr:
-      filter_option = "xhr";
-      break;
-    // a ping request for <a ping>/sendBeacon.
-    case blink::mojom::ResourceType::kPing:
-      filter_option = "ping";
-      break;
-    // the main resource of a dedicated worker.
-    case blink::mojom::ResourceType::kWorker:
-    // the main resource of a shared worker.
-    case blink::mojom::ResourceType::kSharedWorker:
-    // an explicitly requested prefetch
-    case blink::mojom::ResourceType::kPrefetch:
-    // the main resource of a service worker.
-    case blink::mojom::ResourceType::kServiceWorker:
-    // a report of Content Security Policy violations.
-    case blink::mojom::ResourceType::kCspReport:
-    // a resource that a plugin requested.
-    case blink::mojom::ResourceType::kPluginResource:
-    default:
-      break;
-  }
-  return filter_option;
-}
+std::atomic<uint64_t> g_engine_generation{1};
 
 }  // namespace
 
 namespace brave_shields {
 
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate, 1) {}
+
+AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate,
+                                       size_t engine_pool_size)
     : BaseBraveShieldsService(delegate),
-      ad_block_client_(new adblock::Engine()),
+      engine_pool_size_(engine_pool_size),
+      engine_(base::MakeRefCounted<AdBlockEngine>(
+          std::make_unique<adblock::Engine>())),
       weak_factory_(this) {}
 
-AdBlockBaseService::~AdBlockBaseService() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
-}
+AdBlockBaseService::~AdBlockBaseService() = default;
 
 void AdBlockBaseService::ShouldStartRequest(
     const GURL& url,
@@ -121,24 +59,9 @@ void AdBlockBaseService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  ad_block_client_->matches(
-      url.spec(), url.host(), tab_host, is_third_party,
-      ResourceTypeToString(resource_type), did_match_rule,
-      did_match_exception, did_match_important, mock_data_url);
-
-  // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-  //  << tab_host
-  //  << ", resource type: " << resource_type
-  //  << ", url.spec(): " << url.spec();
+  GetEngine()->ShouldStartRequest(url, resource_type, tab_host, did_match_rule,
+                                  did_match_exception, did_match_important,
+                                  mock_data_url);
 }
 
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
@@ -149,17 +72,20 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  std::vector<std::string>::iterator it =
+      std::find(tags_.begin(), tags_.end(), tag);
   if (enabled) {
-    ad_block_client_->addTag(tag);
+    if (it != tags_.end()) {
+      return;
+    }
     tags_.push_back(tag);
   } else {
-    ad_block_client_->removeTag(tag);
-    std::vector<std::string>::iterator it =
-        std::find(tags_.begin(), tags_.end(), tag);
-    if (it != tags_.end()) {
-      tags_.erase(it);
+    if (it == tags_.end()) {
+      return;
     }
+    tags_.erase(it);
   }
+  Rebuild();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -170,27 +96,41 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
-  ad_block_client_->addResources(resources);
+  if (resources == resources_) {
+    return;
+  }
   resources_ = resources;
+  Rebuild();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
+scoped_refptr<AdBlockEngine> AdBlockBaseService::GetEngine() {
+  base::AutoLock lock(engine_lock_);
+  return engine_;
+}
+
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_acquire);
+}
+
+void AdBlockBaseService::OnEngineChanged() {
+  g_engine_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return GetEngine()->UrlCosmeticResources(url);
 }
 
 base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  return GetEngine()->HiddenClassIdSelectors(classes, ids, exceptions);
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
@@ -214,24 +154,74 @@ void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
                                 base::Unretained(this),
-                                std::move(result.first)));
+                                std::move(result.first),
+                                std::move(result.second)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
-    std::unique_ptr<adblock::Engine> ad_block_client) {
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    brave_component_updater::DATFileDataBuffer dat_buffer) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+  dat_buffer_ = std::move(dat_buffer);
+  rules_.clear();
+  AddKnownTagsAndResources(ad_block_client.get());
+  PublishEngine(std::move(ad_block_client));
 }
 
-void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
+void AdBlockBaseService::UpdateRules(const std::string& rules) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  dat_buffer_.clear();
+  rules_ = rules;
+  PublishEngine(CreateEngine());
+}
+
+void AdBlockBaseService::Rebuild() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  PublishEngine(CreateEngine());
+}
+
+std::unique_ptr<adblock::Engine> AdBlockBaseService::CreateEngine() {
+  std::unique_ptr<adblock::Engine> engine;
+  if (!dat_buffer_.empty()) {
+    engine = std::make_unique<adblock::Engine>();
+    if (!engine->deserialize(reinterpret_cast<char*>(&dat_buffer_.front()),
+                             dat_buffer_.size())) {
+      LOG(ERROR) << "Failed to deserialize ad block data";
+      engine = std::make_unique<adblock::Engine>();
+    }
+  } else if (!rules_.empty()) {
+    engine = std::make_unique<adblock::Engine>(rules_);
+  } else {
+    engine = std::make_unique<adblock::Engine>();
+  }
+  AddKnownTagsAndResources(engine.get());
+  return engine;
+}
+
+void AdBlockBaseService::AddKnownTagsAndResources(adblock::Engine* engine) {
   std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+                [&](const std::string tag) { engine->addTag(tag); });
+  engine->addResources(resources_);
 }
 
-void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+void AdBlockBaseService::PublishEngine(
+    std::unique_ptr<adblock::Engine> engine) {
+  DCHECK_GE(engine_pool_size_, 1u);
+  // adblock-rust can't copy an engine, so the rest of the pool is built the
+  // same way as |engine| was.
+  std::vector<std::unique_ptr<adblock::Engine>> engines;
+  engines.push_back(std::move(engine));
+  while (engines.size() < engine_pool_size_)
+    engines.push_back(CreateEngine());
+  scoped_refptr<AdBlockEngine> snapshot =
+      base::MakeRefCounted<AdBlockEngine>(std::move(engines));
+  {
+    base::AutoLock lock(engine_lock_);
+    engine_.swap(snapshot);
+  }
+  OnEngineChanged();
+  // The previous engine is destroyed here unless a request is still
+  // matching against it, in which case that request releases it.
 }
 
 bool AdBlockBaseService::Init() {
@@ -240,15 +230,22 @@ bool AdBlockBaseService::Init() {
 
 void AdBlockBaseService::ResetForTest(const std::string& rules,
                                       const std::string& resources) {
+  if (!GetTaskRunner()->RunsTasksInCurrentSequence()) {
+    GetTaskRunner()->PostTask(
+        FROM_HERE, base::BindOnce(&AdBlockBaseService::ResetForTest,
+                                  base::Unretained(this), rules, resources));
+    return;
+  }
+
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
+  dat_buffer_.clear();
+  rules_ = rules;
   if (!resources.empty()) {
     resources_ = resources;
   }
-  AddKnownResourcesToAdBlockInstance();
+  PublishEngine(CreateEngine());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
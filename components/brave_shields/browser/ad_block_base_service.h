@@ -14,8 +14,10 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
@@ -30,6 +32,8 @@ class Engine;
 
 namespace brave_shields {
 
+class AdBlockEngine;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
@@ -38,6 +42,10 @@ class AdBlockBaseService : public BaseBraveShieldsService {
       brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
+  // Every published snapshot holds |engine_pool_size| identical engines so
+  // that as many queries can run at once, see AdBlockEngine.
+  AdBlockBaseService(BraveComponent::Delegate* delegate,
+                     size_t engine_pool_size);
   ~AdBlockBaseService() override;
 
   void ShouldStartRequest(const GURL& url,
@@ -51,6 +59,14 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Returns the latest engine snapshot. May be called on any thread; the
+  // snapshot stays valid if a new engine is published meanwhile.
+  scoped_refptr<AdBlockEngine> GetEngine();
+
+  // Returns a number which changes whenever the rules of any ad-block engine
+  // change, so that results computed against older engines can be dropped.
+  static uint64_t GetEngineGeneration();
+
   virtual base::Optional<base::Value> UrlCosmeticResources(
       const std::string& url);
   virtual base::Optional<base::Value> HiddenClassIdSelectors(
@@ -63,20 +79,38 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   bool Init() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
-  void AddKnownTagsToAdBlockInstance();
-  void AddKnownResourcesToAdBlockInstance();
+  // Posted to the task runner when called on another sequence.
   void ResetForTest(const std::string& rules, const std::string& resources);
-
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Replaces the rules with the list in |rules| and publishes a new engine.
+  // Must be called on the task runner.
+  void UpdateRules(const std::string& rules);
 
  private:
   void UpdateAdBlockClient(
-      std::unique_ptr<adblock::Engine> ad_block_client);
+      std::unique_ptr<adblock::Engine> ad_block_client,
+      brave_component_updater::DATFileDataBuffer dat_buffer);
   void OnGetDATFileData(GetDATFileDataResult result);
   void OnPreferenceChanges(const std::string& pref_name);
+  // Published engines can't be modified, so tag and resources changes build
+  // and publish a new engine before returning.
+  void Rebuild();
+  std::unique_ptr<adblock::Engine> CreateEngine();
+  void AddKnownTagsAndResources(adblock::Engine* engine);
+  void PublishEngine(std::unique_ptr<adblock::Engine> engine);
+  void OnEngineChanged();
+
+  // The engine is built from either the serialized DAT file or the filter
+  // rules. Only accessed on the task runner.
+  brave_component_updater::DATFileDataBuffer dat_buffer_;
+  std::string rules_;
 
   std::vector<std::string> tags_;
   std::string resources_;
+
+  const size_t engine_pool_size_;
+  base::Lock engine_lock_;
+  scoped_refptr<AdBlockEngine> engine_;
+
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -0,0 +1,173 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace {
+
+std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
+  std::string filter_option = "";
+  switch (resource_type) {
+    // top level page
+    case blink::mojom::ResourceType::kMainFrame:
+      filter_option = "main_frame";
+      break;
+    // frame or iframe
+    case blink::mojom::ResourceType::kSubFrame:
+      filter_option = "sub_frame";
+      break;
+    // a CSS stylesheet
+    case blink::mojom::ResourceType::kStylesheet:
+      filter_option = "stylesheet";
+      break;
+    // an external script
+    case blink::mojom::ResourceType::kScript:
+      filter_option = "script";
+      break;
+    // an image (jpg/gif/png/etc)
+    case blink::mojom::ResourceType::kFavicon:
+    case blink::mojom::ResourceType::kImage:
+      filter_option = "image";
+      break;
+    // a font
+    case blink::mojom::ResourceType::kFontResource:
+      filter_option = "font";
+      break;
+    // an "other" subresource.
+    case blink::mojom::ResourceType::kSubResource:
+      filter_option = "other";
+      break;
+    // an object (or embed) tag for a plugin.
+    case blink::mojom::ResourceType::kObject:
+      filter_option = "object";
+      break;
+    // a media resource.
+    case blink::mojom::ResourceType::kMedia:
+      filter_option = "media";
+      break;
+    // a XMLHttpRequest
+    case blink::mojom::ResourceType::kXhr:
+      filter_option = "xhr";
+      break;
+    // a ping request for <a ping>/sendBeacon.
+    case blink::mojom::ResourceType::kPing:
+      filter_option = "ping";
+      break;
+    // the main resource of a dedicated worker.
+    case blink::mojom::ResourceType::kWorker:
+    // the main resource of a shared worker.
+    case blink::mojom::ResourceType::kSharedWorker:
+    // an explicitly requested prefetch
+    case blink::mojom::ResourceType::kPrefetch:
+    // the main resource of a service worker.
+    case blink::mojom::ResourceType::kServiceWorker:
+    // a report of Content Security Policy violations.
+    case blink::mojom::ResourceType::kCspReport:
+    // a resource that a plugin requested.
+    case blink::mojom::ResourceType::kPluginResource:
+    default:
+      break;
+  }
+  return filter_option;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+AdBlockEngine::Instance::Instance(std::unique_ptr<adblock::Engine> engine)
+    : engine(std::move(engine)) {
+  DCHECK(this->engine);
+}
+
+AdBlockEngine::Instance::~Instance() = default;
+
+AdBlockEngine::AdBlockEngine(
+    std::vector<std::unique_ptr<adblock::Engine>> engines) {
+  DCHECK(!engines.empty());
+  for (auto& engine : engines)
+    instances_.push_back(std::make_unique<Instance>(std::move(engine)));
+}
+
+AdBlockEngine::AdBlockEngine(std::unique_ptr<adblock::Engine> engine) {
+  instances_.push_back(std::make_unique<Instance>(std::move(engine)));
+}
+
+AdBlockEngine::~AdBlockEngine() = default;
+
+AdBlockEngine::Instance* AdBlockEngine::AcquireInstance() const {
+  const size_t first =
+      next_instance_.fetch_add(1, std::memory_order_relaxed) %
+      instances_.size();
+  for (size_t i = 0; i < instances_.size(); i++) {
+    Instance* instance = instances_[(first + i) % instances_.size()].get();
+    if (instance->lock.Try())
+      return instance;
+  }
+  Instance* instance = instances_[first].get();
+  instance->lock.Acquire();
+  return instance;
+}
+
+void AdBlockEngine::ShouldStartRequest(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) const {
+  // Determine third-party here so the library doesn't need to figure it out.
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  bool is_third_party = !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+  Instance* instance = AcquireInstance();
+  base::AutoLock lock(instance->lock, base::AutoLock::AlreadyAcquired());
+  instance->engine->matches(
+      url.spec(), url.host(), tab_host, is_third_party,
+      ResourceTypeToString(resource_type), did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
+}
+
+base::Optional<base::Value> AdBlockEngine::UrlCosmeticResources(
+    const std::string& url) const {
+  std::string resources;
+  {
+    Instance* instance = AcquireInstance();
+    base::AutoLock lock(instance->lock, base::AutoLock::AlreadyAcquired());
+    resources = instance->engine->urlCosmeticResources(url);
+  }
+  return base::JSONReader::Read(resources);
+}
+
+base::Optional<base::Value> AdBlockEngine::HiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) const {
+  std::string selectors;
+  {
+    Instance* instance = AcquireInstance();
+    base::AutoLock lock(instance->lock, base::AutoLock::AlreadyAcquired());
+    selectors =
+        instance->engine->hiddenClassIdSelectors(classes, ids, exceptions);
+  }
+  return base::JSONReader::Read(selectors);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,87 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
+#include "base/values.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace adblock {
+class Engine;
+}
+
+namespace brave_shields {
+
+// A snapshot of adblock-rust engines whose rules, tags and resources are
+// never modified once it is published. Changes are made by publishing a new
+// snapshot; tasks which are still matching against the previous one keep it
+// alive. adblock-rust keeps mutable caches while matching, so a single engine
+// can't be queried concurrently even through its const methods. Instead a
+// snapshot holds a small pool of identical engines, each guarded by its own
+// lock, and every query takes an idle one. Queries only wait for each other
+// once all engines of the pool are busy, and publishing a new snapshot never
+// waits for queries of the old one.
+class AdBlockEngine : public base::RefCountedThreadSafe<AdBlockEngine> {
+ public:
+  // |engines| must all be built from the same rules, tags and resources.
+  explicit AdBlockEngine(std::vector<std::unique_ptr<adblock::Engine>> engines);
+  explicit AdBlockEngine(std::unique_ptr<adblock::Engine> engine);
+
+  void ShouldStartRequest(const GURL& url,
+                          blink::mojom::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url) const;
+  base::Optional<base::Value> UrlCosmeticResources(
+      const std::string& url) const;
+  base::Optional<base::Value> HiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions) const;
+
+  size_t pool_size() const { return instances_.size(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngine>;
+  ~AdBlockEngine();
+
+  struct Instance {
+    explicit Instance(std::unique_ptr<adblock::Engine> engine);
+    ~Instance();
+
+    // Guards every call into |engine|, including ones which look read-only.
+    base::Lock lock;
+    const std::unique_ptr<adblock::Engine> engine;
+  };
+
+  // Returns an instance whose lock is held by the caller. Idle instances are
+  // preferred; if all of them are busy this waits for one.
+  Instance* AcquireInstance() const;
+
+  std::vector<std::unique_ptr<Instance>> instances_;
+  // Spreads queries over the pool so that they don't all probe the same
+  // instance first.
+  mutable std::atomic<size_t> next_instance_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngine);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
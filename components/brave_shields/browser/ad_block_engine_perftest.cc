@@ -0,0 +1,153 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_perftests --filter=AdBlockEnginePerfTest.*
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "AdBlockEngine.";
+constexpr char kMetricQueueingDelayP50[] = "queueing_delay_p50";
+constexpr char kMetricQueueingDelayP99[] = "queueing_delay_p99";
+constexpr char kMetricThroughput[] = "throughput";
+
+constexpr int kRuleCount = 20000;
+constexpr int kRequestCount = 20000;
+// Matches the size of the default engine pool on most machines.
+constexpr size_t kPoolSize = 4;
+
+void DomainResolver(const char* host, uint32_t* start, uint32_t* end) {
+  const std::string host_str(host);
+  const std::string domain =
+      net::registry_controlled_domains::GetDomainAndRegistry(
+          host_str,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  const size_t match = host_str.rfind(domain);
+  if (match != std::string::npos) {
+    *start = match;
+    *end = match + domain.length();
+  } else {
+    *start = 0;
+    *end = host_str.length();
+  }
+}
+
+std::string CreateRules() {
+  std::string rules;
+  for (int i = 0; i < kRuleCount; i++)
+    rules += base::StringPrintf("||ads%d.example.com^\n", i);
+  return rules;
+}
+
+// Half of the requests are blocked.
+GURL CreateRequestURL(int i) {
+  return GURL(base::StringPrintf("https://%s%d.example.com/image.png",
+                                 i % 2 ? "ads" : "cdn", i % kRuleCount));
+}
+
+// Records how long the request had to wait, which is the time from posting
+// it until the match returned minus the CPU time spent matching.
+void MatchRequest(scoped_refptr<AdBlockEngine> engine,
+                  const GURL& url,
+                  base::TimeTicks posted,
+                  base::TimeDelta* queueing_delay,
+                  base::OnceClosure done) {
+  const base::ThreadTicks match_start = base::ThreadTicks::Now();
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+  engine->ShouldStartRequest(url, blink::mojom::ResourceType::kImage, "b.com",
+                             &did_match_rule, &did_match_exception,
+                             &did_match_important, &mock_data_url);
+  const base::TimeDelta match_time = base::ThreadTicks::Now() - match_start;
+  *queueing_delay = base::TimeTicks::Now() - posted - match_time;
+  std::move(done).Run();
+}
+
+}  // namespace
+
+class AdBlockEnginePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!base::ThreadTicks::IsSupported())
+      GTEST_SKIP() << "The queueing delay needs thread CPU time";
+    base::ThreadTicks::WaitUntilInitialized();
+    adblock::SetDomainResolver(DomainResolver);
+  }
+
+  // Posts all requests to the thread pool at once, like a page load starting
+  // many subresource requests, and reports how long they waited for an
+  // engine of a snapshot holding |pool_size| engines.
+  void RunBenchmark(const std::string& story, size_t pool_size) {
+    const std::string rules = CreateRules();
+    std::vector<std::unique_ptr<adblock::Engine>> engines;
+    for (size_t i = 0; i < pool_size; i++)
+      engines.push_back(std::make_unique<adblock::Engine>(rules));
+    scoped_refptr<AdBlockEngine> engine =
+        base::MakeRefCounted<AdBlockEngine>(std::move(engines));
+
+    std::vector<base::TimeDelta> queueing_delays(kRequestCount);
+    base::RunLoop run_loop;
+    base::RepeatingClosure barrier =
+        base::BarrierClosure(kRequestCount, run_loop.QuitClosure());
+
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kRequestCount; i++) {
+      base::PostTask(
+          FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+          base::BindOnce(&MatchRequest, engine, CreateRequestURL(i),
+                         base::TimeTicks::Now(), &queueing_delays[i],
+                         barrier));
+    }
+    run_loop.Run();
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    std::sort(queueing_delays.begin(), queueing_delays.end());
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricQueueingDelayP50, "us");
+    reporter.RegisterImportantMetric(kMetricQueueingDelayP99, "us");
+    reporter.RegisterImportantMetric(kMetricThroughput, "runs/s");
+    reporter.AddResult(kMetricQueueingDelayP50,
+                       queueing_delays[kRequestCount / 2]);
+    reporter.AddResult(kMetricQueueingDelayP99,
+                       queueing_delays[kRequestCount * 99 / 100]);
+    reporter.AddResult(kMetricThroughput,
+                       kRequestCount / elapsed.InSecondsF());
+  }
+
+  base::test::TaskEnvironment task_environment_;
+};
+
+TEST_F(AdBlockEnginePerfTest, SingleEngine) {
+  RunBenchmark("single_engine", 1);
+}
+
+TEST_F(AdBlockEnginePerfTest, EnginePool) {
+  RunBenchmark("engine_pool", kPoolSize);
+}
+
+}  // namespace brave_shields
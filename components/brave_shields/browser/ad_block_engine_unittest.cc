@@ -0,0 +1,230 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/task/post_task.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockEngineTest.*
+
+namespace brave_shields {
+
+namespace {
+
+void DomainResolver(const char* host, uint32_t* start, uint32_t* end) {
+  const std::string host_str(host);
+  const std::string domain =
+      net::registry_controlled_domains::GetDomainAndRegistry(
+          host_str,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  const size_t match = host_str.rfind(domain);
+  if (match != std::string::npos) {
+    *start = match;
+    *end = match + domain.length();
+  } else {
+    *start = 0;
+    *end = host_str.length();
+  }
+}
+
+bool ShouldBlock(const AdBlockEngine& engine,
+                 const GURL& url,
+                 const std::string& tab_host) {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+  engine.ShouldStartRequest(url, blink::mojom::ResourceType::kImage, tab_host,
+                            &did_match_rule, &did_match_exception,
+                            &did_match_important, &mock_data_url);
+  return did_match_important || (did_match_rule && !did_match_exception);
+}
+
+class TestDelegate : public brave_component_updater::BraveComponent::Delegate {
+ public:
+  TestDelegate()
+      : task_runner_(base::CreateSequencedTaskRunner({base::ThreadPool()})) {}
+  ~TestDelegate() override = default;
+
+  // brave_component_updater::BraveComponent::Delegate
+  void Register(const std::string& component_name,
+                const std::string& component_base64_public_key,
+                base::OnceClosure registered_callback,
+                ReadyCallback ready_callback) override {}
+  bool Unregister(const std::string& component_id) override { return true; }
+  void OnDemandUpdate(const std::string& component_id) override {}
+  void AddObserver(ComponentObserver* observer) override {}
+  void RemoveObserver(ComponentObserver* observer) override {}
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner() override {
+    return task_runner_;
+  }
+
+ private:
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+};
+
+class TestAdBlockService : public AdBlockBaseService {
+ public:
+  TestAdBlockService(
+      brave_component_updater::BraveComponent::Delegate* delegate,
+      size_t engine_pool_size)
+      : AdBlockBaseService(delegate, engine_pool_size) {}
+
+  using AdBlockBaseService::UpdateRules;
+};
+
+}  // namespace
+
+class AdBlockEngineTest : public testing::Test {
+ protected:
+  void SetUp() override { adblock::SetDomainResolver(DomainResolver); }
+
+  scoped_refptr<AdBlockEngine> CreateEngine(const std::string& rules,
+                                            size_t pool_size = 1) {
+    std::vector<std::unique_ptr<adblock::Engine>> engines;
+    for (size_t i = 0; i < pool_size; i++)
+      engines.push_back(std::make_unique<adblock::Engine>(rules));
+    return base::MakeRefCounted<AdBlockEngine>(std::move(engines));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+};
+
+TEST_F(AdBlockEngineTest, ShouldStartRequest) {
+  scoped_refptr<AdBlockEngine> engine =
+      CreateEngine("||ads.example.com^\n@@||ads.example.com/allowed.png");
+
+  EXPECT_TRUE(
+      ShouldBlock(*engine, GURL("https://ads.example.com/ad.png"), "b.com"));
+  EXPECT_FALSE(ShouldBlock(*engine, GURL("https://ads.example.com/allowed.png"),
+                           "b.com"));
+  EXPECT_FALSE(
+      ShouldBlock(*engine, GURL("https://cdn.example.com/ad.png"), "b.com"));
+}
+
+// Matches requests against one snapshot from several threads at once, so
+// that both idle and busy engines of the pool are used. This is meant to be
+// run under TSan; see AdBlockEnginePerfTest for the queueing delay.
+TEST_F(AdBlockEngineTest, ConcurrentMatching) {
+  const int kRequests = 2000;
+  scoped_refptr<AdBlockEngine> engine =
+      CreateEngine("||ads.example.com^", 2);
+
+  std::atomic<int> blocked{0};
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(kRequests, run_loop.QuitClosure());
+
+  for (int i = 0; i < kRequests; i++) {
+    const GURL url(i % 2 ? "https://ads.example.com/ad.png"
+                         : "https://cdn.example.com/logo.png");
+    base::PostTask(
+        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(
+            [](scoped_refptr<AdBlockEngine> engine, const GURL& url,
+               std::atomic<int>* blocked, base::OnceClosure done) {
+              if (ShouldBlock(*engine, url, "b.com"))
+                blocked->fetch_add(1);
+              std::move(done).Run();
+            },
+            engine, url, &blocked, barrier));
+  }
+  run_loop.Run();
+
+  EXPECT_EQ(kRequests / 2, blocked.load());
+}
+
+// Matches requests on the thread pool while the service publishes new
+// engines on its task runner, which is meant to be run under TSan.
+TEST_F(AdBlockEngineTest, MatchingWhileEnginesArePublished) {
+  const int kRequests = 1000;
+  const int kUpdates = 50;
+  TestDelegate delegate;
+  TestAdBlockService service(&delegate, 2);
+
+  base::RunLoop initialized_run_loop;
+  delegate.GetTaskRunner()->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(&TestAdBlockService::UpdateRules,
+                     base::Unretained(&service), "||ads.example.com^"),
+      initialized_run_loop.QuitClosure());
+  initialized_run_loop.Run();
+
+  std::atomic<int> blocked{0};
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(kRequests + kUpdates, run_loop.QuitClosure());
+
+  for (int i = 0; i < kUpdates; i++) {
+    // Every version of the rules blocks ads.example.com.
+    const std::string rules = i % 2 ? "||ads.example.com^"
+                                    : "||ads.example.com^\n||tracker.com^";
+    delegate.GetTaskRunner()->PostTaskAndReply(
+        FROM_HERE,
+        base::BindOnce(&TestAdBlockService::UpdateRules,
+                       base::Unretained(&service), rules),
+        barrier);
+  }
+  for (int i = 0; i < kRequests; i++) {
+    const GURL url(i % 2 ? "https://ads.example.com/ad.png"
+                         : "https://cdn.example.com/logo.png");
+    base::PostTask(
+        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(
+            [](TestAdBlockService* service, const GURL& url,
+               std::atomic<int>* blocked, base::OnceClosure done) {
+              if (ShouldBlock(*service->GetEngine(), url, "b.com"))
+                blocked->fetch_add(1);
+              std::move(done).Run();
+            },
+            &service, url, &blocked, barrier));
+  }
+  run_loop.Run();
+
+  EXPECT_EQ(kRequests / 2, blocked.load());
+}
+
+TEST_F(AdBlockEngineTest, PublishesEnginePool) {
+  TestDelegate delegate;
+  TestAdBlockService service(&delegate, 3);
+
+  base::RunLoop run_loop;
+  delegate.GetTaskRunner()->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(&TestAdBlockService::UpdateRules,
+                     base::Unretained(&service),
+                     "||ads.example.com^\n@@||ads.example.com/allowed.png"),
+      run_loop.QuitClosure());
+  run_loop.Run();
+
+  scoped_refptr<AdBlockEngine> engine = service.GetEngine();
+  EXPECT_EQ(3u, engine->pool_size());
+  // Every engine of the pool is built from the same rules, so repeated
+  // queries give the same answer whichever engine they end up on.
+  for (size_t i = 0; i < 2 * engine->pool_size(); i++) {
+    EXPECT_TRUE(
+        ShouldBlock(*engine, GURL("https://ads.example.com/ad.png"), "b.com"));
+    EXPECT_FALSE(ShouldBlock(
+        *engine, GURL("https://ads.example.com/allowed.png"), "b.com"));
+  }
+}
+
+}  // namespace brave_shields
@@ -14,6 +14,7 @@
 #include "base/values.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
@@ -131,10 +132,8 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  base::AutoLock lock(regional_services_lock_);
-
-  for (const auto& regional_service : regional_services_) {
-    regional_service.second->ShouldStartRequest(
+  for (const auto& engine : GetEngines()) {
+    engine->ShouldStartRequest(
         url, resource_type, tab_host, did_match_rule, did_match_exception,
         did_match_important, mock_data_url);
     if (did_match_important && *did_match_important) {
@@ -195,17 +194,17 @@ void AdBlockRegionalServiceManager::EnableFilterList(
 base::Optional<base::Value>
 AdBlockRegionalServiceManager::UrlCosmeticResources(
         const std::string& url) {
-  base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
+  const std::vector<scoped_refptr<AdBlockEngine>> engines = GetEngines();
+  auto it = engines.begin();
+  if (it == engines.end()) {
     return base::Optional<base::Value>();
   }
   base::Optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
+      (*it)->UrlCosmeticResources(url);
 
-  for ( ; it != regional_services_.end(); it++) {
+  for ( ; it != engines.end(); it++) {
     base::Optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
+        (*it)->UrlCosmeticResources(url);
     if (first_value) {
       if (next_value) {
         MergeResourcesInto(std::move(*next_value), &*first_value, false);
@@ -223,17 +222,17 @@ AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
+  const std::vector<scoped_refptr<AdBlockEngine>> engines = GetEngines();
+  auto it = engines.begin();
+  if (it == engines.end()) {
     return base::Optional<base::Value>();
   }
   base::Optional<base::Value> first_value =
-      it->second->HiddenClassIdSelectors(classes, ids, exceptions);
+      (*it)->HiddenClassIdSelectors(classes, ids, exceptions);
 
-  for ( ; it != regional_services_.end(); it++) {
+  for ( ; it != engines.end(); it++) {
     base::Optional<base::Value> next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
+        (*it)->HiddenClassIdSelectors(classes, ids, exceptions);
     if (first_value && first_value->is_list()) {
       if (next_value && next_value->is_list()) {
         for (auto i = next_value->GetList().begin();
@@ -250,6 +249,17 @@ AdBlockRegionalServiceManager::HiddenClassIdSelectors(
   return first_value;
 }
 
+std::vector<scoped_refptr<AdBlockEngine>>
+AdBlockRegionalServiceManager::GetEngines() {
+  std::vector<scoped_refptr<AdBlockEngine>> engines;
+  base::AutoLock lock(regional_services_lock_);
+  engines.reserve(regional_services_.size());
+  for (const auto& regional_service : regional_services_) {
+    engines.push_back(regional_service.second->GetEngine());
+  }
+  return engines;
+}
+
 void AdBlockRegionalServiceManager::SetRegionalCatalog(
         std::vector<adblock::FilterList> catalog) {
   regional_catalog_ = std::move(catalog);
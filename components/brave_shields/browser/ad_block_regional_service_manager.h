@@ -31,6 +31,7 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class AdBlockEngine;
 class AdBlockRegionalService;
 
 // The AdBlock regional service manager, in charge of initializing and
@@ -70,6 +71,9 @@ class AdBlockRegionalServiceManager {
   bool Init();
   void StartRegionalServices();
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
+  // Returns the engines of the regional services, so that they can be queried
+  // without holding |regional_services_lock_|.
+  std::vector<scoped_refptr<AdBlockEngine>> GetEngines();
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
   bool initialized_;
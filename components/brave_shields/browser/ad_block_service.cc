@@ -16,12 +16,14 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/system/sys_info.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/browser/domain_block_pre_filter.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -35,6 +37,19 @@ namespace brave_shields {
 
 namespace {
 
+// Bounds the number of URLs remembered by the domain block pre-filter.
+constexpr size_t kMaxDomainBlockPreFilterURLs = 1024;
+
+// The default engine is queried for nearly every request, so it is published
+// as a pool of engines which are matched against in parallel. Each of them
+// holds the whole default list in memory, so the pool stays small.
+constexpr int kMaxEnginePoolSize = 4;
+
+size_t GetEnginePoolSize() {
+  return std::max(1, std::min(base::SysInfo::NumberOfProcessors(),
+                              kMaxEnginePoolSize));
+}
+
 std::string GetTagFromPrefName(const std::string& pref_name) {
   if (pref_name == kFBEmbedControlType) {
     return brave_shields::kFacebookEmbeds;
@@ -179,9 +194,16 @@ AdBlockService::custom_filters_service() {
   return custom_filters_service_.get();
 }
 
+DomainBlockPreFilter* AdBlockService::domain_block_pre_filter() {
+  return domain_block_pre_filter_.get();
+}
+
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
-    : AdBlockBaseService(delegate), component_delegate_(delegate) {}
+    : AdBlockBaseService(delegate, GetEnginePoolSize()),
+      domain_block_pre_filter_(std::make_unique<DomainBlockPreFilter>(
+          kMaxDomainBlockPreFilterURLs)),
+      component_delegate_(delegate) {}
 
 AdBlockService::~AdBlockService() {}
 
@@ -192,6 +214,11 @@ bool AdBlockService::Init() {
   if (!AdBlockBaseService::Init())
     return false;
 
+  // Requests are matched on worker threads, which must not race to create
+  // these lazily.
+  regional_service_manager();
+  custom_filters_service();
+
   Register(kAdBlockComponentName, g_ad_block_component_id_,
            g_ad_block_component_base64_public_key_);
   return true;
@@ -30,6 +30,7 @@ namespace brave_shields {
 
 class AdBlockRegionalServiceManager;
 class AdBlockCustomFiltersService;
+class DomainBlockPreFilter;
 
 const char kAdBlockResourcesFilename[] = "resources.json";
 const char kAdBlockComponentName[] = "Brave Ad Block Updater";
@@ -66,6 +67,9 @@ class AdBlockService : public AdBlockBaseService {
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
 
+  // May be used on any thread.
+  DomainBlockPreFilter* domain_block_pre_filter();
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
@@ -89,6 +93,8 @@ class AdBlockService : public AdBlockBaseService {
   std::unique_ptr<brave_shields::AdBlockCustomFiltersService>
       custom_filters_service_;
 
+  std::unique_ptr<DomainBlockPreFilter> domain_block_pre_filter_;
+
   BraveComponent::Delegate* component_delegate_;
 
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
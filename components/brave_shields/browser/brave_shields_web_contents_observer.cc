@@ -11,7 +11,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/no_destructor.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/default_tick_clock.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -53,6 +57,37 @@ using content::WebContents;
 
 namespace {
 
+constexpr base::TimeDelta kDispatchBlockedEventsInterval =
+    base::TimeDelta::FromMilliseconds(100);
+constexpr base::TimeDelta kWriteStatsInterval =
+    base::TimeDelta::FromSeconds(5);
+
+bool g_write_stats_immediately_for_testing = false;
+const base::TickClock* g_timer_tick_clock_for_testing = nullptr;
+
+scoped_refptr<base::SequencedTaskRunner>& GetTimerTaskRunnerForTesting() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>>
+      task_runner;
+  return *task_runner;
+}
+
+const base::TickClock* GetTimerTickClock() {
+  return g_timer_tick_clock_for_testing ? g_timer_tick_clock_for_testing
+                                        : base::DefaultTickClock::GetInstance();
+}
+
+const char* GetStatsPrefName(const std::string& block_type) {
+  if (block_type == brave_shields::kAds)
+    return kAdsBlocked;
+  if (block_type == brave_shields::kHTTPUpgradableResources)
+    return kHttpsUpgrades;
+  if (block_type == brave_shields::kJavaScript)
+    return kJavascriptBlocked;
+  if (block_type == brave_shields::kFingerprintingV2)
+    return kFingerprintingBlocked;
+  return nullptr;
+}
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -135,7 +170,14 @@ BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      dispatch_blocked_events_timer_(GetTimerTickClock()),
+      write_stats_timer_(GetTimerTickClock()) {
+  if (GetTimerTaskRunnerForTesting()) {
+    dispatch_blocked_events_timer_.SetTaskRunner(
+        GetTimerTaskRunnerForTesting());
+    write_stats_timer_.SetTaskRunner(GetTimerTaskRunnerForTesting());
+  }
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
@@ -231,34 +273,89 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  BraveShieldsWebContentsObserver* observer =
+      web_contents
+          ? BraveShieldsWebContentsObserver::FromWebContents(web_contents)
+          : nullptr;
+  if (!observer) {
+    DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+    return;
+  }
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  observer->QueueBlockedEvent(block_type, subresource);
+  if (!observer->IsBlockedSubresource(subresource)) {
+    observer->AddBlockedSubresource(subresource);
+    observer->CountBlockedResource(block_type);
   }
 }
 
+// static
+void BraveShieldsWebContentsObserver::SetWriteStatsImmediatelyForTesting(
+    bool immediately) {
+  g_write_stats_immediately_for_testing = immediately;
+}
+
+// static
+void BraveShieldsWebContentsObserver::SetTimerTaskRunnerForTesting(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const base::TickClock* tick_clock) {
+  GetTimerTaskRunnerForTesting() = std::move(task_runner);
+  g_timer_tick_clock_for_testing = tick_clock;
+}
+
+void BraveShieldsWebContentsObserver::QueueBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  queued_blocked_events_.push_back({block_type, subresource});
+  if (!dispatch_blocked_events_timer_.IsRunning()) {
+    dispatch_blocked_events_timer_.Start(
+        FROM_HERE, kDispatchBlockedEventsInterval,
+        base::BindOnce(
+            &BraveShieldsWebContentsObserver::DispatchQueuedBlockedEvents,
+            base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::DispatchQueuedBlockedEvents() {
+  dispatch_blocked_events_timer_.Stop();
+
+  std::vector<QueuedBlockedEvent> events;
+  events.swap(queued_blocked_events_);
+  DispatchBlockedEventsForWebContents(events, web_contents());
+}
+
+void BraveShieldsWebContentsObserver::CountBlockedResource(
+    const std::string& block_type) {
+  const char* pref_name = GetStatsPrefName(block_type);
+  if (!pref_name)
+    return;
+
+  ++pending_stats_[pref_name];
+  if (g_write_stats_immediately_for_testing) {
+    WriteStats();
+  } else if (!write_stats_timer_.IsRunning()) {
+    write_stats_timer_.Start(
+        FROM_HERE, kWriteStatsInterval,
+        base::BindOnce(&BraveShieldsWebContentsObserver::WriteStats,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::WriteStats() {
+  write_stats_timer_.Stop();
+  if (pending_stats_.empty() || !web_contents())
+    return;
+
+  PrefService* prefs =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+          ->GetOriginalProfile()
+          ->GetPrefs();
+  for (const auto& stat : pending_stats_) {
+    prefs->SetUint64(stat.first, prefs->GetUint64(stat.first) + stat.second);
+  }
+  pending_stats_.clear();
+}
+
 #if !defined(OS_ANDROID)
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
@@ -271,7 +368,9 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   Profile* profile =
       Profile::FromBrowserContext(web_contents->GetBrowserContext());
   EventRouter* event_router = EventRouter::Get(profile);
-  if (profile && event_router) {
+  if (profile && event_router &&
+      event_router->HasEventListener(
+          extensions::api::brave_shields::OnBlocked::kEventName)) {
     extensions::api::brave_shields::OnBlocked::Details details;
     details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
     details.block_type = block_type;
@@ -287,6 +386,42 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   }
 #endif
 }
+
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<QueuedBlockedEvent>& events,
+    WebContents* web_contents) {
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  if (!web_contents || events.empty()) {
+    return;
+  }
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  EventRouter* event_router = EventRouter::Get(profile);
+  if (!profile || !event_router ||
+      !event_router->HasEventListener(
+          extensions::api::brave_shields::OnBlockedResources::kEventName)) {
+    return;
+  }
+
+  const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+  std::vector<extensions::api::brave_shields::OnBlockedResources::DetailsType>
+      details(events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    details[i].tab_id = tab_id;
+    details[i].block_type = events[i].block_type;
+    details[i].subresource = events[i].subresource;
+  }
+  std::unique_ptr<base::ListValue> args(
+      extensions::api::brave_shields::OnBlockedResources::Create(details)
+        .release());
+  std::unique_ptr<Event> event(
+      new Event(extensions::events::BRAVE_AD_BLOCKED,
+        extensions::api::brave_shields::OnBlockedResources::kEventName,
+        std::move(args)));
+  event_router->BroadcastEvent(std::move(event));
+#endif
+}
 #endif
 
 bool BraveShieldsWebContentsObserver::OnMessageReceived(
@@ -311,8 +446,7 @@ void BraveShieldsWebContentsObserver::OnJavaScriptBlockedWithDetail(
   if (!web_contents) {
     return;
   }
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-      base::UTF16ToUTF8(details), web_contents);
+  QueueBlockedEvent(brave_shields::kJavaScript, base::UTF16ToUTF8(details));
 }
 
 void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
@@ -323,8 +457,8 @@ void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
   if (!web_contents) {
     return;
   }
-  DispatchBlockedEventForWebContents(brave_shields::kFingerprintingV2,
-      base::UTF16ToUTF8(details), web_contents);
+  QueueBlockedEvent(brave_shields::kFingerprintingV2,
+                    base::UTF16ToUTF8(details));
 }
 
 // static
@@ -343,6 +477,8 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    // Events of the previous page go out before the new one commits.
+    DispatchQueuedBlockedEvents();
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
@@ -360,6 +496,12 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
         MSG_ROUTING_NONE, allowed_script_origins_));
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  dispatch_blocked_events_timer_.Stop();
+  queued_blocked_events_.clear();
+  WriteStats();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins, WebContents* contents) {
   allowed_script_origins_ = std::move(origins);
@@ -12,11 +12,19 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
+namespace base {
+class SequencedTaskRunner;
+class TickClock;
+}  // namespace base
+
 namespace content {
 class WebContents;
 }
@@ -49,6 +57,15 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
+  // Blocked resources are added to the lifetime stats prefs from a timer,
+  // tests which check the prefs right away have them written immediately.
+  static void SetWriteStatsImmediatelyForTesting(bool immediately);
+  // Observers created afterwards run their batching timers on |task_runner|
+  // and |tick_clock|, tests pass a mock to fast forward through the intervals.
+  static void SetTimerTaskRunnerForTesting(
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      const base::TickClock* tick_clock);
+
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
   struct RenderFrameIdKey {
@@ -74,6 +91,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,11 +112,37 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  struct QueuedBlockedEvent {
+    std::string block_type;
+    std::string subresource;
+  };
+
+  // Blocked events are dispatched in batches instead of one by one, pages
+  // blocking lots of resources would otherwise keep the UI thread busy.
+  void QueueBlockedEvent(const std::string& block_type,
+                         const std::string& subresource);
+  void DispatchQueuedBlockedEvents();
+  static void DispatchBlockedEventsForWebContents(
+      const std::vector<QueuedBlockedEvent>& events,
+      content::WebContents* web_contents);
+
+  // Lifetime stats are counted in memory and written to prefs on a timer so
+  // that prefs observers (e.g. the NTP) are not notified for every resource.
+  void CountBlockedResource(const std::string& block_type);
+  void WriteStats();
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
 
+  std::vector<QueuedBlockedEvent> queued_blocked_events_;
+  base::OneShotTimer dispatch_blocked_events_timer_;
+  // Resources blocked since the stats were last written, by pref name.
+  std::map<std::string, uint64_t> pending_stats_;
+  base::OneShotTimer write_stats_timer_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
 };
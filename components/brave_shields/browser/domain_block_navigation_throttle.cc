@@ -16,6 +16,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/domain_block_controller_client.h"
 #include "brave/components/brave_shields/browser/domain_block_page.h"
+#include "brave/components/brave_shields/browser/domain_block_pre_filter.h"
 #include "brave/components/brave_shields/browser/domain_block_tab_storage.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "components/prefs/pref_service.h"
@@ -30,10 +31,13 @@
 
 namespace {
 
-bool ShouldBlockDomainOnTaskRunner(
+bool ShouldBlockDomainOnWorker(
     brave_shields::AdBlockService* ad_block_service,
-    const GURL& url) {
+    const GURL& url,
+    bool is_off_the_record) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.DomainBlock.ShouldBlock");
+  const uint64_t engine_generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
   bool did_match_exception = false;
   bool did_match_rule = false;
   bool did_match_important = false;
@@ -41,7 +45,15 @@ bool ShouldBlockDomainOnTaskRunner(
   ad_block_service->ShouldStartRequest(
       url, blink::mojom::ResourceType::kMainFrame, url.host(), &did_match_rule,
       &did_match_exception, &did_match_important, &mock_data_url);
-  return (did_match_important || (did_match_rule && !did_match_exception));
+  const bool should_block =
+      did_match_important || (did_match_rule && !did_match_exception);
+  // The pre-filter is shared by all profiles, so don't let it remember the
+  // URLs visited off the record.
+  if (!should_block && !is_off_the_record) {
+    ad_block_service->domain_block_pre_filter()->AddAllowedURL(
+        url, engine_generation);
+  }
+  return should_block;
 }
 
 }  // namespace
@@ -101,12 +113,22 @@ DomainBlockNavigationThrottle::WillStartRequest() {
   if (tab_storage->IsProceeding())
     return content::NavigationThrottle::PROCEED;
 
-  // Otherwise, call the ad block service on a task runner to determine whether
-  // this domain should be blocked.
-  ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&ShouldBlockDomainOnTaskRunner, ad_block_service_,
-                     request_url),
+  // Most navigations were already allowed by the current rules, so look them
+  // up in the pre-filter before paying for a round trip to a worker thread.
+  const bool may_block = ad_block_service_->domain_block_pre_filter()->MayBlock(
+      request_url, AdBlockBaseService::GetEngineGeneration());
+  UMA_HISTOGRAM_BOOLEAN("Brave.DomainBlock.Deferred", may_block);
+  if (!may_block)
+    return content::NavigationThrottle::PROCEED;
+
+  // Otherwise, call the ad block service on a worker thread to determine
+  // whether this domain should be blocked.
+  defer_start_time_ = base::TimeTicks::Now();
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&ShouldBlockDomainOnWorker, ad_block_service_,
+                     request_url,
+                     web_contents->GetBrowserContext()->IsOffTheRecord()),
       base::BindOnce(&DomainBlockNavigationThrottle::OnShouldBlockDomain,
                      weak_ptr_factory_.GetWeakPtr()));
 
@@ -123,6 +145,8 @@ DomainBlockNavigationThrottle::WillRedirectRequest() {
 
 void DomainBlockNavigationThrottle::OnShouldBlockDomain(
     bool should_block_domain) {
+  UMA_HISTOGRAM_TIMES("Brave.DomainBlock.DeferralTime",
+                      base::TimeTicks::Now() - defer_start_time_);
   if (should_block_domain) {
     ShowInterstitial();
   } else {
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/navigation_throttle.h"
 #include "url/gurl.h"
 
@@ -56,6 +57,7 @@ class DomainBlockNavigationThrottle : public content::NavigationThrottle {
   AdBlockService* ad_block_service_ = nullptr;
   AdBlockCustomFiltersService* ad_block_custom_filters_service_ = nullptr;
   std::string locale_;
+  base::TimeTicks defer_start_time_;
   base::WeakPtrFactory<DomainBlockNavigationThrottle> weak_ptr_factory_{this};
 };
 
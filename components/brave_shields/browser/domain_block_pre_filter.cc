@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/domain_block_pre_filter.h"
+
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::string GetEntryKey(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
+}  // namespace
+
+DomainBlockPreFilter::DomainBlockPreFilter(size_t max_urls)
+    : allowed_urls_(max_urls) {}
+
+DomainBlockPreFilter::~DomainBlockPreFilter() = default;
+
+void DomainBlockPreFilter::AddAllowedURL(const GURL& url,
+                                         uint64_t engine_generation) {
+  base::AutoLock lock(lock_);
+  // The engines changed while this result was computed
+  if (engine_generation < engine_generation_)
+    return;
+  if (engine_generation > engine_generation_) {
+    allowed_urls_.Clear();
+    engine_generation_ = engine_generation;
+  }
+  allowed_urls_.Put(GetEntryKey(url), true);
+}
+
+bool DomainBlockPreFilter::MayBlock(const GURL& url,
+                                    uint64_t engine_generation) const {
+  base::AutoLock lock(lock_);
+  if (engine_generation != engine_generation_)
+    return true;
+  return allowed_urls_.Peek(GetEntryKey(url)) == allowed_urls_.end();
+}
+
+size_t DomainBlockPreFilter::size() const {
+  base::AutoLock lock(lock_);
+  return allowed_urls_.size();
+}
+
+}  // namespace brave_shields
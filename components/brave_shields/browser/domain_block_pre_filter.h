@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DOMAIN_BLOCK_PRE_FILTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DOMAIN_BLOCK_PRE_FILTER_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/synchronization/lock.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// Remembers the URLs whose main frame navigations the ad-block engines have
+// already let through, so that the domain block throttle can let further
+// navigations to them proceed without deferring them. Entries are keyed by
+// the whole URL but its fragment, as $document rules may match paths or
+// queries, e.g. "||example.com/bad$document". URLs are added from worker
+// threads and looked up on the UI thread; both only hold the lock for a hash
+// lookup.
+class DomainBlockPreFilter {
+ public:
+  explicit DomainBlockPreFilter(size_t max_urls);
+  ~DomainBlockPreFilter();
+
+  DomainBlockPreFilter(const DomainBlockPreFilter&) = delete;
+  DomainBlockPreFilter& operator=(const DomainBlockPreFilter&) = delete;
+
+  // Records that no engine of |engine_generation| blocks |url|. URLs cleared
+  // by older engines are dropped once a newer generation is recorded.
+  void AddAllowedURL(const GURL& url, uint64_t engine_generation);
+
+  // Returns true if |url| has to be checked against the engines of
+  // |engine_generation| before the navigation can proceed.
+  bool MayBlock(const GURL& url, uint64_t engine_generation) const;
+
+  size_t size() const;
+
+ private:
+  mutable base::Lock lock_;
+  uint64_t engine_generation_ = 0;
+  base::HashingMRUCache<std::string, bool> allowed_urls_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DOMAIN_BLOCK_PRE_FILTER_H_
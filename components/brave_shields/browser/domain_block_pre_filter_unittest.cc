@@ -0,0 +1,76 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/domain_block_pre_filter.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=DomainBlockPreFilterTest.*
+
+namespace brave_shields {
+
+TEST(DomainBlockPreFilterTest, EmptyFilterDefersEverything) {
+  DomainBlockPreFilter pre_filter(8);
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("https://brave.com/"), 0));
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("https://brave.com/"), 1));
+}
+
+TEST(DomainBlockPreFilterTest, AllowedURLs) {
+  DomainBlockPreFilter pre_filter(8);
+  pre_filter.AddAllowedURL(GURL("https://brave.com/download?os=linux#top"), 1);
+
+  EXPECT_FALSE(
+      pre_filter.MayBlock(GURL("https://brave.com/download?os=linux"), 1));
+  EXPECT_FALSE(pre_filter.MayBlock(
+      GURL("https://brave.com/download?os=linux#bottom"), 1));
+  // $document rules may match paths and queries
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("https://brave.com/"), 1));
+  EXPECT_TRUE(
+      pre_filter.MayBlock(GURL("https://brave.com/download?os=mac"), 1));
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("http://brave.com/download?os=linux"),
+                                  1));
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("https://search.brave.com/"), 1));
+  EXPECT_EQ(1u, pre_filter.size());
+
+  pre_filter.AddAllowedURL(GURL("https://brave.com/download?os=linux"), 1);
+  EXPECT_EQ(1u, pre_filter.size());
+}
+
+TEST(DomainBlockPreFilterTest, RulesUpdateInvalidatesFilter) {
+  const GURL url("https://brave.com/");
+  DomainBlockPreFilter pre_filter(8);
+  pre_filter.AddAllowedURL(url, 1);
+  EXPECT_FALSE(pre_filter.MayBlock(url, 1));
+  EXPECT_TRUE(pre_filter.MayBlock(url, 2));
+
+  pre_filter.AddAllowedURL(GURL("https://example.com/"), 2);
+  EXPECT_EQ(1u, pre_filter.size());
+  EXPECT_TRUE(pre_filter.MayBlock(url, 2));
+  EXPECT_FALSE(pre_filter.MayBlock(GURL("https://example.com/"), 2));
+}
+
+TEST(DomainBlockPreFilterTest, IgnoresResultsFromOlderEngines) {
+  const GURL url("https://brave.com/");
+  DomainBlockPreFilter pre_filter(8);
+  pre_filter.AddAllowedURL(GURL("https://example.com/"), 2);
+  pre_filter.AddAllowedURL(url, 1);
+  EXPECT_TRUE(pre_filter.MayBlock(url, 2));
+  EXPECT_EQ(1u, pre_filter.size());
+}
+
+TEST(DomainBlockPreFilterTest, EvictsLeastRecentlyAllowedURLs) {
+  DomainBlockPreFilter pre_filter(2);
+  pre_filter.AddAllowedURL(GURL("https://a.com/"), 1);
+  pre_filter.AddAllowedURL(GURL("https://b.com/"), 1);
+  pre_filter.AddAllowedURL(GURL("https://c.com/"), 1);
+
+  EXPECT_EQ(2u, pre_filter.size());
+  EXPECT_TRUE(pre_filter.MayBlock(GURL("https://a.com/"), 1));
+  EXPECT_FALSE(pre_filter.MayBlock(GURL("https://b.com/"), 1));
+  EXPECT_FALSE(pre_filter.MayBlock(GURL("https://c.com/"), 1));
+}
+
+}  // namespace brave_shields
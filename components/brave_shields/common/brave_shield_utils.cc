@@ -9,17 +9,24 @@
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "url/gurl.h"
 
-ContentSetting GetBraveFPContentSettingFromRules(
-    const ContentSettingsForOneType& fp_rules,
-    const GURL& primary_url) {
+namespace {
+
+// Evaluates the rules in |rules| in order, |get_rule| returns the rule an
+// element of |rules| refers to.
+template <typename Rules, typename GetRule>
+ContentSetting GetBraveFPContentSetting(const Rules& rules,
+                                        GetRule get_rule,
+                                        const GURL& primary_url) {
+  const ContentSettingsPattern balanced_pattern =
+      ContentSettingsPattern::FromString("https://balanced");
   base::Optional<ContentSettingPatternSource> global_fp_rule;
   base::Optional<ContentSettingPatternSource> global_fp_balanced_rule;
 
-  for (const auto& rule : fp_rules) {
+  for (const auto& element : rules) {
+    const ContentSettingPatternSource& rule = get_rule(element);
     if (rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
         rule.primary_pattern.Matches(primary_url)) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+      if (rule.secondary_pattern == balanced_pattern) {
         return CONTENT_SETTING_DEFAULT;
       }
       if (rule.secondary_pattern == ContentSettingsPattern::Wildcard())
@@ -27,8 +34,7 @@ ContentSetting GetBraveFPContentSettingFromRules(
     }
 
     if (rule.primary_pattern == ContentSettingsPattern::Wildcard()) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+      if (rule.secondary_pattern == balanced_pattern) {
         DCHECK(!global_fp_rule);
         global_fp_balanced_rule = rule;
       }
@@ -47,3 +53,27 @@ ContentSetting GetBraveFPContentSettingFromRules(
 
   return CONTENT_SETTING_DEFAULT;
 }
+
+}  // namespace
+
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const GURL& primary_url) {
+  return GetBraveFPContentSetting(
+      fp_rules,
+      [](const ContentSettingPatternSource& rule)
+          -> const ContentSettingPatternSource& { return rule; },
+      primary_url);
+}
+
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const std::vector<size_t>& candidate_rules,
+    const GURL& primary_url) {
+  return GetBraveFPContentSetting(
+      candidate_rules,
+      [&fp_rules](size_t index) -> const ContentSettingPatternSource& {
+        return fp_rules[index];
+      },
+      primary_url);
+}
@@ -6,6 +6,10 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
 
+#include <stddef.h>
+
+#include <vector>
+
 #include "components/content_settings/core/common/content_settings.h"
 
 class GURL;
@@ -14,4 +18,12 @@ ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url);
 
+// Same as above, but only evaluates the rules of |fp_rules| at the indices in
+// |candidate_rules|. They must be in increasing order and include every rule
+// which may match |primary_url| as well as the global rules.
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const std::vector<size_t>& candidate_rules,
+    const GURL& primary_url);
+
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_shields/common/brave_shield_utils.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex() = default;
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex(
+    const ContentSettingsForOneType& rules)
+    : rules_(&rules) {
+  std::vector<std::pair<std::string, std::vector<size_t>>> rules_by_host;
+  base::flat_map<std::string, size_t> host_positions;
+  for (size_t i = 0; i < rules.size(); i++) {
+    const ContentSettingPatternSource& rule = rules[i];
+    if (rule.secondary_pattern != ContentSettingsPattern::Wildcard())
+      has_only_wildcard_secondary_patterns_ = false;
+
+    const std::string& host = rule.primary_pattern.GetHost();
+    if (rule.primary_pattern.MatchesAllHosts() || host.empty()) {
+      host_independent_rules_.push_back(i);
+      continue;
+    }
+    auto position = host_positions.find(host);
+    if (position == host_positions.end()) {
+      position = host_positions.emplace(host, rules_by_host.size()).first;
+      rules_by_host.emplace_back(host, std::vector<size_t>());
+    }
+    rules_by_host[position->second].second.push_back(i);
+  }
+  rules_by_host_ =
+      base::flat_map<std::string, std::vector<size_t>>(std::move(rules_by_host));
+}
+
+ContentSettingsRulesIndex::~ContentSettingsRulesIndex() = default;
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex(
+    ContentSettingsRulesIndex&&) = default;
+ContentSettingsRulesIndex& ContentSettingsRulesIndex::operator=(
+    ContentSettingsRulesIndex&&) = default;
+
+ContentSetting ContentSettingsRulesIndex::GetContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  if (!rules_)
+    return CONTENT_SETTING_DEFAULT;
+
+  for (const size_t i : GetCandidateRules(primary_url)) {
+    const ContentSettingPatternSource& rule = (*rules_)[i];
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.GetContentSetting();
+    }
+  }
+  return CONTENT_SETTING_DEFAULT;
+}
+
+ContentSetting ContentSettingsRulesIndex::GetBraveFPContentSetting(
+    const GURL& primary_url) const {
+  if (!rules_)
+    return CONTENT_SETTING_DEFAULT;
+
+  // The candidates include the global rules, which match all hosts.
+  return GetBraveFPContentSettingFromRules(
+      *rules_, GetCandidateRules(primary_url), primary_url);
+}
+
+std::vector<size_t> ContentSettingsRulesIndex::GetCandidateRules(
+    const GURL& primary_url) const {
+  std::vector<size_t> candidates = host_independent_rules_;
+
+  // Rules for the host itself and for domain wildcards of its parents.
+  base::StringPiece host = primary_url.host_piece();
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  while (!host.empty()) {
+    const auto it = rules_by_host_.find(host);
+    if (it != rules_by_host_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(),
+                        it->second.end());
+    }
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+}  // namespace content_settings
@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "components/content_settings/core/common/content_settings.h"
+
+class GURL;
+
+namespace content_settings {
+
+// Buckets content setting rules by the host of their primary pattern, so that
+// a lookup only evaluates the rules which may match the host of the primary
+// URL or one of its parent domains. Rules keep their precedence, so results
+// are the same as scanning the list in order.
+// |rules| is not copied and must outlive the index.
+class ContentSettingsRulesIndex {
+ public:
+  ContentSettingsRulesIndex();
+  explicit ContentSettingsRulesIndex(const ContentSettingsForOneType& rules);
+  ~ContentSettingsRulesIndex();
+
+  ContentSettingsRulesIndex(ContentSettingsRulesIndex&&);
+  ContentSettingsRulesIndex& operator=(ContentSettingsRulesIndex&&);
+
+  // Returns the setting of the first rule matching both URLs, or
+  // CONTENT_SETTING_DEFAULT if there is none.
+  ContentSetting GetContentSetting(const GURL& primary_url,
+                                   const GURL& secondary_url) const;
+
+  // Same as |GetBraveFPContentSettingFromRules|, evaluated on the candidate
+  // rules only.
+  ContentSetting GetBraveFPContentSetting(const GURL& primary_url) const;
+
+  // True if no rule depends on the secondary URL, so results can be reused
+  // for any secondary URL.
+  bool has_only_wildcard_secondary_patterns() const {
+    return has_only_wildcard_secondary_patterns_;
+  }
+
+ private:
+  // Returns indices of the rules which may match |primary_url|, in order.
+  std::vector<size_t> GetCandidateRules(const GURL& primary_url) const;
+
+  const ContentSettingsForOneType* rules_ = nullptr;
+  base::flat_map<std::string, std::vector<size_t>> rules_by_host_;
+  // Rules matching any host, or URLs without a host.
+  std::vector<size_t> host_independent_rules_;
+  bool has_only_wildcard_secondary_patterns_ = true;
+};
+
+}  // namespace content_settings
+
+#endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
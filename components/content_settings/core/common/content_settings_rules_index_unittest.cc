@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/values.h"
+#include "brave/components/brave_shields/common/brave_shield_utils.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=ContentSettingsRulesIndexTest.*
+
+namespace content_settings {
+
+namespace {
+
+ContentSettingPatternSource MakeRule(const std::string& primary_pattern,
+                                     const std::string& secondary_pattern,
+                                     ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+// Reference implementation, same as the renderer used to do.
+ContentSetting GetContentSettingLinear(const ContentSettingsForOneType& rules,
+                                       const GURL& primary_url,
+                                       const GURL& secondary_url) {
+  for (const auto& rule : rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.GetContentSetting();
+    }
+  }
+  return CONTENT_SETTING_DEFAULT;
+}
+
+// Site exceptions followed by the global rule, like the renderer gets them.
+ContentSettingsForOneType MakeSiteExceptions(size_t count) {
+  ContentSettingsForOneType rules;
+  for (size_t i = 0; i < count; i++) {
+    const ContentSetting setting =
+        i % 2 ? CONTENT_SETTING_BLOCK : CONTENT_SETTING_ALLOW;
+    if (i % 3) {
+      rules.push_back(MakeRule(base::StringPrintf("[*.]site%zu.com", i), "*",
+                               setting));
+    } else {
+      rules.push_back(MakeRule(base::StringPrintf("https://site%zu.com:443", i),
+                               "*", setting));
+    }
+  }
+  rules.push_back(MakeRule("*", "*", CONTENT_SETTING_ALLOW));
+  return rules;
+}
+
+std::vector<GURL> MakeLookupURLs(size_t count) {
+  std::vector<GURL> urls;
+  for (size_t i = 0; i < count; i += 7) {
+    urls.push_back(GURL(base::StringPrintf("https://site%zu.com/", i)));
+    urls.push_back(GURL(base::StringPrintf("https://www.site%zu.com/", i)));
+    urls.push_back(GURL(base::StringPrintf("http://site%zu.com./", i)));
+  }
+  urls.push_back(GURL("https://unknown.com/"));
+  urls.push_back(GURL("file:///tmp/index.html"));
+  urls.push_back(GURL("https://127.0.0.1/"));
+  return urls;
+}
+
+}  // namespace
+
+TEST(ContentSettingsRulesIndexTest, MatchesLinearScan) {
+  for (const size_t count : {1000u, 10000u}) {
+    const ContentSettingsForOneType rules = MakeSiteExceptions(count);
+    const ContentSettingsRulesIndex index(rules);
+    const GURL secondary_url("https://cdn.example.com/script.js");
+
+    for (const GURL& url : MakeLookupURLs(count)) {
+      EXPECT_EQ(GetContentSettingLinear(rules, url, secondary_url),
+                index.GetContentSetting(url, secondary_url))
+          << url;
+    }
+  }
+}
+
+TEST(ContentSettingsRulesIndexTest, KeepsRulePrecedence) {
+  ContentSettingsForOneType rules;
+  rules.push_back(
+      MakeRule("https://www.example.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  rules.push_back(MakeRule("*", "https://cdn.com", CONTENT_SETTING_BLOCK));
+  rules.push_back(MakeRule("*", "*", CONTENT_SETTING_ALLOW));
+  const ContentSettingsRulesIndex index(rules);
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            index.GetContentSetting(GURL("https://www.example.com/"),
+                                    GURL("https://cdn.com/")));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            index.GetContentSetting(GURL("https://a.b.example.com/"),
+                                    GURL("https://cdn.com/")));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            index.GetContentSetting(GURL("https://other.com/"),
+                                    GURL("https://cdn.com/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            index.GetContentSetting(GURL("https://other.com/"),
+                                    GURL("https://other.com/")));
+  EXPECT_FALSE(index.has_only_wildcard_secondary_patterns());
+}
+
+TEST(ContentSettingsRulesIndexTest, ReturnsDefaultWithoutMatch) {
+  ContentSettingsForOneType rules;
+  rules.push_back(MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  const ContentSettingsRulesIndex index(rules);
+
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            index.GetContentSetting(GURL("https://notexample.com/"),
+                                    GURL("https://notexample.com/")));
+  EXPECT_TRUE(index.has_only_wildcard_secondary_patterns());
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            ContentSettingsRulesIndex().GetContentSetting(
+                GURL("https://example.com/"), GURL("https://example.com/")));
+}
+
+TEST(ContentSettingsRulesIndexTest, MatchesBraveFPContentSetting) {
+  ContentSettingsForOneType rules;
+  rules.push_back(MakeRule("*", "*", CONTENT_SETTING_BLOCK));
+  rules.push_back(
+      MakeRule("[*.]balanced.com", "https://balanced", CONTENT_SETTING_BLOCK));
+  rules.push_back(MakeRule("[*.]allowed.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(MakeRule("[*.]blocked.com", "*", CONTENT_SETTING_BLOCK));
+  const ContentSettingsRulesIndex index(rules);
+
+  for (const char* url : {"https://balanced.com/", "https://www.allowed.com/",
+                          "https://blocked.com/", "https://other.com/"}) {
+    EXPECT_EQ(GetBraveFPContentSettingFromRules(rules, GURL(url)),
+              index.GetBraveFPContentSetting(GURL(url)))
+        << url;
+  }
+
+  rules.push_back(MakeRule("*", "https://balanced", CONTENT_SETTING_BLOCK));
+  rules.erase(rules.begin());
+  const ContentSettingsRulesIndex balanced_index(rules);
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            balanced_index.GetBraveFPContentSetting(GURL("https://other.com/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW, balanced_index.GetBraveFPContentSetting(
+                                       GURL("https://allowed.com/")));
+}
+
+}  // namespace content_settings
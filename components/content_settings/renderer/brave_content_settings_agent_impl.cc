@@ -12,11 +12,12 @@
 
 #include "base/callback_helpers.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
-#include "brave/components/brave_shields/common/brave_shield_utils.h"
 #include "brave/components/brave_shields/common/features.h"
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
 #include "brave/content/common/frame_messages.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_utils.h"
@@ -52,21 +53,34 @@ GURL GetOriginOrURL(const blink::WebFrame* frame) {
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
-    }
+struct CompiledContentSettingRules {
+  const RendererContentSettingRules* source = nullptr;
+  uint64_t generation = 0;
+  ContentSettingsRulesIndex brave_shields_rules;
+  ContentSettingsRulesIndex fingerprinting_rules;
+  ContentSettingsRulesIndex autoplay_rules;
+};
+
+// All frames of a renderer share the same rules, so they are indexed once per
+// update rather than per frame. Only used on the render thread.
+const CompiledContentSettingRules& GetCompiledRules(
+    const RendererContentSettingRules& rules) {
+  static base::NoDestructor<CompiledContentSettingRules> compiled_rules;
+  // Rules that weren't received over IPC have no generation, so there is no
+  // way to tell if they are up to date.
+  if (compiled_rules->source != &rules ||
+      compiled_rules->generation != rules.brave_rules_generation ||
+      rules.brave_rules_generation == 0) {
+    compiled_rules->source = &rules;
+    compiled_rules->generation = rules.brave_rules_generation;
+    compiled_rules->brave_shields_rules =
+        ContentSettingsRulesIndex(rules.brave_shields_rules);
+    compiled_rules->fingerprinting_rules =
+        ContentSettingsRulesIndex(rules.fingerprinting_rules);
+    compiled_rules->autoplay_rules =
+        ContentSettingsRulesIndex(rules.autoplay_rules);
   }
-
-  return setting == CONTENT_SETTING_BLOCK;
+  return *compiled_rules;
 }
 
 }  // namespace
@@ -103,6 +117,7 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  cached_decisions_ = CachedDecisions{cached_decisions_.rules_generation};
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -237,28 +252,54 @@ void BraveContentSettingsAgentImpl::DidBlockFingerprinting(
   Send(new BraveViewHostMsg_FingerprintingBlocked(routing_id(), details));
 }
 
+bool BraveContentSettingsAgentImpl::UpdateCachedDecisions() {
+  if (!content_setting_rules_)
+    return false;
+
+  const uint64_t generation = content_setting_rules_->brave_rules_generation;
+  if (generation != cached_decisions_.rules_generation) {
+    // Storage access depends on cookie settings which might have changed
+    // along with the rules.
+    cached_storage_permissions_.clear();
+  }
+  if (generation == 0 || generation != cached_decisions_.rules_generation)
+    cached_decisions_ = CachedDecisions{generation};
+  return true;
+}
+
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+  if (!UpdateCachedDecisions())
+    return true;
+  if (cached_decisions_.shields_down)
+    return *cached_decisions_.shields_down;
+
+  const ContentSettingsRulesIndex& shields_rules =
+      GetCompiledRules(*content_setting_rules_).brave_shields_rules;
+  const bool shields_down =
+      shields_rules.GetContentSetting(GetOriginOrURL(frame), secondary_url) ==
+      CONTENT_SETTING_BLOCK;
+  // Shields are toggled per site, so the secondary URL doesn't matter unless
+  // there are unusual rules.
+  if (shields_rules.has_only_wildcard_secondary_patterns())
+    cached_decisions_.shields_down = shields_down;
+  return shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-
+  // The farbling level is OFF when shields are down.
   return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  // Called for every farbled canvas, WebGL and audio call.
+  if (UpdateCachedDecisions() && cached_decisions_.farbling_level)
+    return *cached_decisions_.farbling_level;
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
@@ -267,21 +308,27 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
                            url::Origin(frame->GetSecurityOrigin()).GetURL())) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
-      setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
+      setting = GetCompiledRules(*content_setting_rules_)
+                    .fingerprinting_rules.GetBraveFPContentSetting(
+                        GetOriginOrURL(frame));
     }
   }
 
+  BraveFarblingLevel farbling_level;
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    farbling_level = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    farbling_level = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    farbling_level = BraveFarblingLevel::BALANCED;
   }
+
+  if (content_setting_rules_)
+    cached_decisions_.farbling_level = farbling_level;
+  return farbling_level;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -294,10 +341,14 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
   }
 
   // respect user's site blocklist, if any
-  if (content_setting_rules_) {
-    ContentSetting setting =
-        GetContentSettingFromRules(content_setting_rules_->autoplay_rules,
-                                   frame, url::Origin(origin).GetURL());
+  if (UpdateCachedDecisions()) {
+    if (!cached_decisions_.autoplay_setting) {
+      cached_decisions_.autoplay_setting =
+          GetCompiledRules(*content_setting_rules_)
+              .autoplay_rules.GetContentSetting(GetOriginOrURL(frame),
+                                                url::Origin(origin).GetURL());
+    }
+    ContentSetting setting = *cached_decisions_.autoplay_setting;
     if (setting == CONTENT_SETTING_BLOCK) {
       VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
       if (play_requested)
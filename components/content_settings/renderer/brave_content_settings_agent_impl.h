@@ -13,6 +13,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -62,6 +63,10 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
       const blink::WebFrame* frame,
       const GURL& secondary_url);
 
+  // Drops memoized decisions if new content setting rules have arrived.
+  // Returns false if there are no rules.
+  bool UpdateCachedDecisions();
+
   // RenderFrameObserver
   bool OnMessageReceived(const IPC::Message& message) override;
   void OnAllowScriptsOnce(const std::vector<std::string>& origins);
@@ -83,6 +88,20 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   using StoragePermissionsKey = std::pair<url::Origin, StorageType>;
   base::flat_map<StoragePermissionsKey, bool> cached_storage_permissions_;
 
+  // Decisions for the current document, reset on commit and when new content
+  // setting rules arrive.
+  struct CachedDecisions {
+    // Generation of the rules the decisions were made with, 0 if they
+    // shouldn't be cached.
+    uint64_t rules_generation = 0;
+    // Shields state for the frame origin, or for any URL if shields rules
+    // don't depend on the secondary URL.
+    base::Optional<bool> shields_down;
+    base::Optional<BraveFarblingLevel> farbling_level;
+    base::Optional<ContentSetting> autoplay_setting;
+  };
+  CachedDecisions cached_decisions_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -9,6 +9,7 @@
 
 #include "base/json/json_reader.h"
 #include "base/optional.h"
+#include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -63,8 +64,8 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
     }
   }
 
-  ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
-      FROM_HERE,
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
       base::BindOnce(&brave_shields::AdBlockService::HiddenClassIdSelectors,
                      base::Unretained(ad_block_service_), classes, ids,
                      exceptions),
@@ -100,8 +101,8 @@ void CosmeticFiltersResources::ShouldDoCosmeticFiltering(
 void CosmeticFiltersResources::UrlCosmeticResources(
     const std::string& url,
     UrlCosmeticResourcesCallback callback) {
-  ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
-      FROM_HERE,
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
       base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
                      base::Unretained(ad_block_service_), url),
       base::BindOnce(&CosmeticFiltersResources::UrlCosmeticResourcesOnUI,
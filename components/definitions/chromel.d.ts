@@ -269,6 +269,10 @@ declare namespace chrome.braveShields {
     addListener: (callback: (detail: BlockDetails) => void) => void
     emit: (detail: BlockDetails) => void
   }
+  const onBlockedResources: {
+    addListener: (callback: (details: BlockDetails[]) => void) => void
+    emit: (details: BlockDetails[]) => void
+  }
 
   const allowScriptsOnce: any
   const setBraveShieldsEnabledAsync: any
@@ -196,6 +196,12 @@ declare namespace Rewards {
     weight: number
   }
 
+  export interface PublisherListPage {
+    cursor: number
+    nextCursor?: number
+    publishers: Publisher[]
+  }
+
   export interface ExcludedPublisher {
     id: string
     status: PublisherStatus
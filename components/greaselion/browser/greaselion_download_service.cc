@@ -156,29 +156,35 @@ bool GreaselionRule::PreconditionFulfilled(
   }
 }
 
-bool GreaselionRule::Matches(
-    GreaselionFeatures state, const base::Version& browser_version) const {
+bool GreaselionRule::Matches(const GreaselionFeatures& state,
+                             const base::Version& browser_version) const {
+  auto feature_enabled = [&state](GreaselionFeature feature) {
+    auto iter = state.find(feature);
+    return iter != state.end() && iter->second;
+  };
+
   // Validate against preconditions.
   if (!PreconditionFulfilled(preconditions_.rewards_enabled,
-                             state[greaselion::REWARDS]))
+                             feature_enabled(greaselion::REWARDS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.twitter_tips_enabled,
-                             state[greaselion::TWITTER_TIPS]))
+                             feature_enabled(greaselion::TWITTER_TIPS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.reddit_tips_enabled,
-                             state[greaselion::REDDIT_TIPS]))
+                             feature_enabled(greaselion::REDDIT_TIPS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.github_tips_enabled,
-                             state[greaselion::GITHUB_TIPS]))
+                             feature_enabled(greaselion::GITHUB_TIPS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.auto_contribution_enabled,
-                             state[greaselion::AUTO_CONTRIBUTION]))
+                             feature_enabled(greaselion::AUTO_CONTRIBUTION)))
     return false;
-  if (!PreconditionFulfilled(preconditions_.supports_minimum_brave_version,
-                          state[greaselion::SUPPORTS_MINIMUM_BRAVE_VERSION]))
+  if (!PreconditionFulfilled(
+          preconditions_.supports_minimum_brave_version,
+          feature_enabled(greaselion::SUPPORTS_MINIMUM_BRAVE_VERSION)))
     return false;
   if (!PreconditionFulfilled(preconditions_.ads_enabled,
-                             state[greaselion::ADS]))
+                             feature_enabled(greaselion::ADS)))
     return false;
   // Validate against browser version.
   if (base::Version::IsValidWildcardString(minimum_brave_version_)) {
@@ -274,6 +280,7 @@ void GreaselionDownloadService::LoadDirectlyFromResourcePath() {
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_generation_++;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,17 +65,13 @@ class GreaselionRule {
              const std::string& minimum_brave_version_value,
              const base::FilePath& messages_value,
              const base::FilePath& resource_dir);
-  bool Matches(
-      GreaselionFeatures state, const base::Version& browser_version) const;
-  std::string name() const { return name_; }
-  std::vector<std::string> url_patterns() const { return url_patterns_; }
-  std::vector<base::FilePath> scripts() const { return scripts_; }
-  std::string run_at() const {
-    return run_at_;
-  }
-  base::FilePath messages() const {
-    return messages_;
-  }
+  bool Matches(const GreaselionFeatures& state,
+               const base::Version& browser_version) const;
+  const std::string& name() const { return name_; }
+  const std::vector<std::string>& url_patterns() const { return url_patterns_; }
+  const std::vector<base::FilePath>& scripts() const { return scripts_; }
+  const std::string& run_at() const { return run_at_; }
+  const base::FilePath& messages() const { return messages_; }
   bool has_unknown_preconditions() const { return has_unknown_preconditions_; }
 
  private:
@@ -104,6 +102,10 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
+  // Incremented every time the rules are reloaded, so that consumers can tell
+  // whether rules they have already processed are still current.
+  uint64_t rules_generation() const { return rules_generation_; }
+
   // implementation of LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
@@ -129,6 +131,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  uint64_t rules_generation_ = 0;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
   scoped_refptr<base::SequencedTaskRunner> dev_mode_task_runner_;
@@ -48,6 +48,10 @@ class GreaselionService : public KeyedService,
   virtual void UpdateInstalledExtensions() = 0;
   virtual bool IsGreaselionExtension(const std::string& id) = 0;
   virtual std::vector<extensions::ExtensionId> GetExtensionIdsForTesting() = 0;
+  // Number of bundles the last update loaded as-is, and the number it had to
+  // convert from the rules first.
+  virtual int GetReusedBundleCountForTesting() = 0;
+  virtual int GetConvertedBundleCountForTesting() = 0;
   virtual bool ready() = 0;
 
   // implementation of our own observers
@@ -6,7 +6,10 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +19,15 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -50,28 +57,94 @@ namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
+// Converted rules are kept in this subdirectory of the install directory,
+// one bundle per rule hash.
+constexpr base::FilePath::CharType kBundlesDirectory[] =
+    FILE_PATH_LITERAL("Bundles");
+
+// Bump this whenever the layout of a converted bundle changes so that bundles
+// written by older versions are not reused.
+constexpr char kBundleFormatVersion[] = "1";
+
+// Number of bytes of the rule hash used to name a bundle directory
+constexpr size_t kBundleKeyLength = 16;
+
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a
+// public key.
+std::string GetPublicKeySeed(const std::string& script_name) {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    return UPDATER_DEV_ENDPOINT + script_name;
+  }
+  return UPDATER_PROD_ENDPOINT + script_name;
+}
+
+void AppendFileInfo(const base::FilePath& path, std::string* input) {
+  base::File::Info info;
+  input->append("\n" + path.AsUTF8Unsafe());
+  if (!base::GetFileInfo(path, &info))
+    return;
+  input->append(":" + base::NumberToString(info.size));
+  input->append(":" + base::NumberToString(
+                          info.last_modified.ToDeltaSinceWindowsEpoch()
+                              .InMicroseconds()));
+}
+
+// Returns the name of the bundle directory for |rule|. The key covers
+// everything which ends up in the converted extension, including the size and
+// modification time of the referenced files, so a new component version (or
+// an edited file in dev mode) results in a new bundle.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-base::Optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
-    const greaselion::GreaselionRule& rule,
-    const base::FilePath& install_dir) {
+std::string GetBundleKey(const greaselion::GreaselionRule& rule) {
+  std::string input = kBundleFormatVersion;
+  input.append("\n" + GetPublicKeySeed(rule.name()));
+  input.append("\n" + rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    input.append("\n" + url_pattern);
+  for (const auto& script : rule.scripts())
+    AppendFileInfo(script, &input);
+
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> messages;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      messages.push_back(path);
+    }
+    std::sort(messages.begin(), messages.end());
+    input.append("\n" + rule.messages().AsUTF8Unsafe());
+    for (const auto& path : messages)
+      AppendFileInfo(path, &input);
+  }
+
+  const std::string hash = crypto::SHA256HashString(input);
+  return base::ToLowerASCII(base::HexEncode(hash.data(), kBundleKeyLength));
+}
+
+// Writes the unpacked extension for |rule| to |bundle_dir|. The extension is
+// assembled in a temporary directory first and only moved into place once
+// complete, so a bundle directory is never left half-written.
+bool WriteGreaselionBundle(const greaselion::GreaselionRule& rule,
+                           const base::FilePath& install_dir,
+                           const base::FilePath& bundle_dir) {
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(install_dir);
   if (install_temp_dir.empty()) {
     LOG(ERROR) << "Could not get path to profile temp directory";
-    return base::nullopt;
+    return false;
   }
 
   base::ScopedTempDir temp_dir;
   if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
     LOG(ERROR) << "Could not create Greaselion temp directory";
-    return base::nullopt;
+    return false;
   }
 
   // Create the manifest
@@ -82,26 +155,11 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
 
   // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
-  std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  }
+  const std::string& script_name = rule.name();
+  crypto::SHA256HashString(GetPublicKeySeed(script_name), raw,
+                           crypto::kSHA256Length);
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
 
   root->SetStringPath(extensions::manifest_keys::kName, script_name);
@@ -111,16 +169,12 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   root->SetStringPath("incognito",
                       extensions::manifest_values::kIncognitoNotAllowed);
 
-  std::vector<std::string> matches;
-  matches.reserve(rule.url_patterns().size());
-  for (auto url_pattern : rule.url_patterns())
-    matches.push_back(url_pattern);
-
   extensions::api::content_scripts::ContentScript content_script;
-  content_script.matches = std::move(matches);
+  content_script.matches = rule.url_patterns();
 
   content_script.js = std::make_unique<std::vector<std::string>>();
-  for (auto script : rule.scripts())
+  content_script.js->reserve(rule.scripts().size());
+  for (const auto& script : rule.scripts())
     content_script.js->push_back(script.BaseName().AsUTF8Unsafe());
 
   // All Greaselion scripts default to document end.
@@ -149,7 +203,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return base::nullopt;
+    return false;
   }
 
   // Copy the messages directory to our extension directory.
@@ -159,33 +213,91 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             temp_dir.GetPath().AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return base::nullopt;
+      return false;
     }
   }
 
   // Copy the script files to our extension directory.
-  for (auto script : rule.scripts()) {
+  for (const auto& script : rule.scripts()) {
     if (!base::CopyFile(script,
                         temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return base::nullopt;
+      return false;
     }
   }
 
+  if (!base::CreateDirectory(bundle_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), bundle_dir)) {
+    LOG(ERROR) << "Could not move Greaselion bundle into place at path: "
+               << bundle_dir.LossyDisplayName();
+    return false;
+  }
+
+  // The bundle directory now owns the files
+  ignore_result(temp_dir.Take());
+  return true;
+}
+
+// Wraps a Greaselion rule in a component. The component is stored as
+// an unpacked extension in the user data dir and reused for as long as the
+// rule does not change. Returns a valid extension, or base::nullopt.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+base::Optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
+ConvertGreaselionRuleToExtensionOnTaskRunner(
+    const greaselion::GreaselionRule& rule,
+    const base::FilePath& install_dir) {
+  const base::FilePath bundle_dir =
+      install_dir.Append(kBundlesDirectory).AppendASCII(GetBundleKey(rule));
+
   std::string error;
+  if (base::DirectoryExists(bundle_dir)) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        bundle_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+    if (extension.get())
+      return std::make_pair(extension, true);
+
+    LOG(WARNING) << "Could not load cached Greaselion bundle, rebuilding it: "
+                 << error;
+    base::DeletePathRecursively(bundle_dir);
+  }
+
+  if (!WriteGreaselionBundle(rule, install_dir, bundle_dir))
+    return base::nullopt;
+
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+      bundle_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
+    base::DeletePathRecursively(bundle_dir);
     return base::nullopt;
   }
 
-  // Take ownership of this temporary directory so it's deleted when
-  // the service exits
-  return std::make_pair(extension, std::move(temp_dir));
+  return std::make_pair(extension, false);
 }
+
+// Deletes the bundles which do not belong to any of |rules|, e.g. those of
+// previous component versions.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+void DeleteStaleBundlesOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules,
+    const base::FilePath& install_dir) {
+  std::set<std::string> current_keys;
+  for (const auto& rule : rules)
+    current_keys.insert(GetBundleKey(rule));
+
+  base::FileEnumerator enumerator(install_dir.Append(kBundlesDirectory), false,
+                                  base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (current_keys.count(path.BaseName().AsUTF8Unsafe()) == 0)
+      base::DeletePathRecursively(path);
+  }
+}
+
 }  // namespace
 
 namespace greaselion {
@@ -230,12 +342,44 @@ GreaselionServiceImpl::GetExtensionIdsForTesting() {
   return greaselion_extensions_;
 }
 
+int GreaselionServiceImpl::GetReusedBundleCountForTesting() {
+  return reused_bundles_;
+}
+
+int GreaselionServiceImpl::GetConvertedBundleCountForTesting() {
+  return converted_bundles_;
+}
+
+std::vector<std::string> GreaselionServiceImpl::GetMatchingRuleNames() {
+  std::vector<std::string> names;
+  for (const auto& rule : *download_service_->rules()) {
+    if (rule->Matches(state_, browser_version_) &&
+        rule->has_unknown_preconditions() == false) {
+      names.push_back(rule->name());
+    }
+  }
+  return names;
+}
+
+bool GreaselionServiceImpl::NeedsUpdate() {
+  // Nothing to do if the same rules would be installed again, e.g. when a
+  // feature is toggled which none of the rules depend on.
+  return !all_rules_installed_successfully_ ||
+         installed_rules_generation_ != download_service_->rules_generation() ||
+         greaselion_extensions_.size() != installed_rules_.size() ||
+         GetMatchingRuleNames() != installed_rules_;
+}
+
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
   if (update_in_progress_) {
     update_pending_ = true;
     return;
   }
+  if (!NeedsUpdate())
+    return;
+
   update_in_progress_ = true;
+  update_start_time_ = base::TimeTicks::Now();
   if (greaselion_extensions_.empty()) {
     // No Greaselion extensions are currently installed, so we can move on to
     // the install phase immediately.
@@ -260,33 +404,51 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
   DCHECK(greaselion_extensions_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
+  reused_bundles_ = 0;
+  converted_bundles_ = 0;
   std::vector<std::unique_ptr<GreaselionRule>>* rules =
       download_service_->rules();
+  installed_rules_.clear();
+  installed_rules_generation_ = download_service_->rules_generation();
+
+  std::vector<GreaselionRule> matching_rules;
   for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
     if (rule->Matches(state_, browser_version_) &&
         rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+      matching_rules.push_back(*rule);
+      installed_rules_.push_back(rule->name());
     }
   }
+
+  if (!stale_bundles_removed_ && !rules->empty()) {
+    // Bundles of previous component versions are removed once per session,
+    // before any bundle of this session is loaded.
+    stale_bundles_removed_ = true;
+    std::vector<GreaselionRule> all_rules;
+    for (const std::unique_ptr<GreaselionRule>& rule : *rules)
+      all_rules.push_back(*rule);
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&DeleteStaleBundlesOnTaskRunner,
+                                          std::move(all_rules),
+                                          install_directory_));
+  }
+
+  pending_installs_ = static_cast<int>(matching_rules.size());
   if (!pending_installs_) {
     // no rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (const GreaselionRule& rule : matching_rules) {
+    // Convert script file to component extension, or reuse the bundle
+    // converted earlier. This must run on extension file task runner, which
+    // was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr()));
   }
 }
 
@@ -298,8 +460,11 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
+    if (converted_extension->second)
+      reused_bundles_++;
+    else
+      converted_bundles_++;
     greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -355,10 +520,18 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 void GreaselionServiceImpl::MaybeNotifyObservers() {
   if (!pending_installs_) {
     update_in_progress_ = false;
-    if (update_pending_) {
+    const base::TimeDelta update_time =
+        base::TimeTicks::Now() - update_start_time_;
+    UMA_HISTOGRAM_TIMES("Brave.Greaselion.UpdateTime", update_time);
+    VLOG(1) << "Greaselion installed " << installed_rules_.size()
+            << " rule(s) in " << update_time.InMilliseconds() << " ms ("
+            << reused_bundles_ << " reused, " << converted_bundles_
+            << " converted)";
+    if (update_pending_ && NeedsUpdate()) {
       update_pending_ = false;
       UpdateInstalledExtensions();
     } else {
+      update_pending_ = false;
       for (Observer& observer : observers_)
         observer.OnExtensionsReady(this, all_rules_installed_successfully_);
     }
@@ -368,6 +541,8 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
+  if (state_[feature] == enabled)
+    return;
   state_[feature] = enabled;
   UpdateInstalledExtensions();
 }
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -13,10 +15,10 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
+#include "base/time/time.h"
 #include "base/version.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
@@ -52,6 +54,8 @@ class GreaselionServiceImpl : public GreaselionService {
   void UpdateInstalledExtensions() override;
   bool IsGreaselionExtension(const std::string& id) override;
   std::vector<extensions::ExtensionId> GetExtensionIdsForTesting() override;
+  int GetReusedBundleCountForTesting() override;
+  int GetConvertedBundleCountForTesting() override;
   bool ready() override;
   void AddObserver(Observer* observer) override;
   void RemoveObserver(Observer* observer) override;
@@ -63,11 +67,15 @@ class GreaselionServiceImpl : public GreaselionService {
                            const extensions::Extension* extension,
                            extensions::UnloadedExtensionReason reason) override;
 
+  // The converted extension, and whether it was loaded from a bundle which
+  // had been converted earlier.
   using GreaselionConvertedExtension =
-      std::pair<scoped_refptr<extensions::Extension>, base::ScopedTempDir>;
+      std::pair<scoped_refptr<extensions::Extension>, bool>;
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  std::vector<std::string> GetMatchingRuleNames();
+  bool NeedsUpdate();
   void CreateAndInstallExtensions();
   void PostConvert(
       base::Optional<GreaselionConvertedExtension> converted_extension);
@@ -87,7 +95,14 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Names of the rules installed by the last update, and the generation of
+  // the download service rules they were taken from
+  std::vector<std::string> installed_rules_;
+  uint64_t installed_rules_generation_ = 0;
+  bool stale_bundles_removed_ = false;
+  int reused_bundles_ = 0;
+  int converted_bundles_ = 0;
+  base::TimeTicks update_start_time_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
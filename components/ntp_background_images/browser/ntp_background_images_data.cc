@@ -223,7 +223,7 @@ bool NTPBackgroundImagesData::IsSuperReferral() const {
   return IsValid() && !theme_name.empty();
 }
 
-base::Value NTPBackgroundImagesData::GetBackgroundAt(size_t index) {
+base::Value NTPBackgroundImagesData::GetBackgroundAt(size_t index) const {
   DCHECK(index >= 0 && index < wallpaper_image_urls().size());
 
   base::Value data(base::Value::Type::DICTIONARY);
@@ -76,7 +76,7 @@ struct NTPBackgroundImagesData {
 
   bool IsValid() const;
   // Generate Value with background image at |index|.
-  base::Value GetBackgroundAt(size_t index);
+  base::Value GetBackgroundAt(size_t index) const;
   std::vector<TopSite> GetTopSitesForWebUI() const;
 
   bool IsSuperReferral() const;
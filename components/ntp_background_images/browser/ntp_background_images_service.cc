@@ -56,6 +56,13 @@ std::string GetMappingTableData(const base::FilePath& installed_dir) {
   return contents;
 }
 
+NTPBackgroundImagesService::MappingTableResult LoadMappingTable(
+    const base::FilePath& installed_dir,
+    const std::string& promo_code) {
+  return NTPBackgroundImagesService::ParseMappingTable(
+      GetMappingTableData(installed_dir), promo_code);
+}
+
 // If registered component is for sponsored images wallpaper, it has photo.json
 // in |installed_dir|. Otherwise, it has data.json for super referral.
 // This methods cache super referral's favicon data because that favicon images
@@ -80,8 +87,72 @@ std::string HandleComponentData(const base::FilePath& installed_dir) {
   return contents;
 }
 
+NTPBackgroundImagesService::ComponentData LoadComponentData(
+    const base::FilePath& installed_dir) {
+  return NTPBackgroundImagesService::ParseComponentData(
+      HandleComponentData(installed_dir), installed_dir);
+}
+
 }  // namespace
 
+NTPBackgroundImagesService::ComponentData::ComponentData() = default;
+NTPBackgroundImagesService::ComponentData::ComponentData(
+    ComponentData&& other) = default;
+NTPBackgroundImagesService::ComponentData&
+NTPBackgroundImagesService::ComponentData::operator=(
+    ComponentData&& other) = default;
+NTPBackgroundImagesService::ComponentData::~ComponentData() = default;
+
+NTPBackgroundImagesService::MappingTableResult::MappingTableResult() = default;
+NTPBackgroundImagesService::MappingTableResult::MappingTableResult(
+    MappingTableResult&& other) = default;
+NTPBackgroundImagesService::MappingTableResult&
+NTPBackgroundImagesService::MappingTableResult::operator=(
+    MappingTableResult&& other) = default;
+NTPBackgroundImagesService::MappingTableResult::~MappingTableResult() =
+    default;
+
+// static
+NTPBackgroundImagesService::ComponentData
+NTPBackgroundImagesService::ParseComponentData(
+    const std::string& json_string,
+    const base::FilePath& installed_dir) {
+  ComponentData data;
+  data.images_data =
+      std::make_unique<NTPBackgroundImagesData>(json_string, installed_dir);
+  data.json_string = json_string;
+  return data;
+}
+
+// static
+NTPBackgroundImagesService::MappingTableResult
+NTPBackgroundImagesService::ParseMappingTable(const std::string& json_string,
+                                              const std::string& promo_code) {
+  MappingTableResult result;
+  if (json_string.empty()) {
+    DVLOG(2) << __func__ << ": Mapping table is empty.";
+    return result;
+  }
+
+  base::Optional<base::Value> mapping_table_value =
+      base::JSONReader::Read(json_string);
+
+  if (!mapping_table_value) {
+    DVLOG(2) << __func__ << ": has invalid mapping table.";
+    return result;
+  }
+
+  if (!mapping_table_value->is_dict()) {
+    DVLOG(2) << __func__ << ": Mapping table is empty.";
+    return result;
+  }
+
+  result.is_valid = true;
+  if (base::Value* value = mapping_table_value->FindDictKey(promo_code))
+    result.component_info = std::move(*value);
+  return result;
+}
+
 // static
 void NTPBackgroundImagesService::RegisterLocalStatePrefs(
     PrefRegistrySimple* registry) {
@@ -184,9 +255,13 @@ void NTPBackgroundImagesService::CheckSuperReferralComponent() {
     const std::string cached_data = local_pref_->GetString(
         prefs::kNewTabPageCachedSuperReferralComponentData);
     if (!cached_data.empty()) {
-      DVLOG(2) << __func__ << ": Initialized SR Data from cache.";
-      sr_images_data_.reset(
-          new NTPBackgroundImagesData(cached_data, si_installed_dir_));
+      base::PostTaskAndReplyWithResult(
+          FROM_HERE, {base::ThreadPool()},
+          base::BindOnce(&NTPBackgroundImagesService::ParseComponentData,
+                         cached_data, si_installed_dir_),
+          base::BindOnce(
+              &NTPBackgroundImagesService::OnGetCachedSuperReferralData,
+              weak_factory_.GetWeakPtr()));
     }
     return;
   }
@@ -336,40 +411,26 @@ void NTPBackgroundImagesService::OnMappingTableComponentReady(
     return;
   }
 
+  // Only the entry for current promo code is extracted from the mapping table
+  // on the background sequence.
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&GetMappingTableData, installed_dir),
+      base::BindOnce(&LoadMappingTable, installed_dir, GetReferralPromoCode()),
       base::BindOnce(&NTPBackgroundImagesService::OnGetMappingTableData,
                      weak_factory_.GetWeakPtr()));
 }
 
 void NTPBackgroundImagesService::OnGetMappingTableData(
-    const std::string& json_string) {
-  if (json_string.empty()) {
-    DVLOG(2) << __func__ << ": Mapping table is empty.";
+    MappingTableResult result) {
+  if (!result.is_valid)
     return;
-  }
-
-  base::Optional<base::Value> mapping_table_value =
-      base::JSONReader::Read(json_string);
-
-  if (!mapping_table_value) {
-    DVLOG(2) << __func__ << ": has invalid mapping table.";
-    return;
-  }
-
-  if (!mapping_table_value->is_dict()) {
-    DVLOG(2) << __func__ << ": Mapping table is empty.";
-    return;
-  }
 
   DVLOG(2) << __func__ << ": Downloaded valid mapping table.";
 
-  if (const base::Value* value =
-          mapping_table_value->FindDictKey(GetReferralPromoCode())) {
+  if (result.component_info.is_dict()) {
     DVLOG(2) << __func__
              << ": This is super referral. Cache SR's referral code";
-    initial_sr_component_info_ = value->Clone();
+    initial_sr_component_info_ = std::move(result.component_info);
     RegisterSuperReferralComponent();
     local_pref_->SetString(prefs::kNewTabPageCachedSuperReferralCode,
                            GetReferralPromoCode());
@@ -434,21 +495,20 @@ void NTPBackgroundImagesService::OnComponentReady(
 
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&HandleComponentData, installed_dir),
+      base::BindOnce(&LoadComponentData, installed_dir),
       base::BindOnce(&NTPBackgroundImagesService::OnGetComponentJsonData,
                      weak_factory_.GetWeakPtr(),
                      is_super_referral));
 }
 
-void NTPBackgroundImagesService::OnGetComponentJsonData(
-    bool is_super_referral,
-    const std::string& json_string) {
+void NTPBackgroundImagesService::OnGetComponentJsonData(bool is_super_referral,
+                                                        ComponentData data) {
+  DCHECK(data.images_data);
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
           false);
-    sr_images_data_.reset(
-        new NTPBackgroundImagesData(json_string, sr_installed_dir_));
+    sr_images_data_ = std::move(data.images_data);
     // |initial_sr_component_info_| has proper data only for initial component
     // downloading. After that, it's empty. In test, it's also empty.
     if (initial_sr_component_info_.is_dict()) {
@@ -457,10 +517,9 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
     }
     CacheTopSitesFaviconList();
     local_pref_->SetString(prefs::kNewTabPageCachedSuperReferralComponentData,
-                           json_string);
+                           data.json_string);
   } else {
-    si_images_data_.reset(new NTPBackgroundImagesData(json_string,
-                                                      si_installed_dir_));
+    si_images_data_ = std::move(data.images_data);
   }
 
   if (is_super_referral && !sr_images_data_->IsValid()) {
@@ -476,6 +535,19 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
   }
 }
 
+void NTPBackgroundImagesService::OnGetCachedSuperReferralData(
+    ComponentData data) {
+  DCHECK(data.images_data);
+  // Data from the component itself is newer than the cached one.
+  if (sr_images_data_)
+    return;
+
+  DVLOG(2) << __func__ << ": Initialized SR Data from cache.";
+  sr_images_data_ = std::move(data.images_data);
+  for (auto& observer : observer_list_)
+    observer.OnUpdated(sr_images_data_.get());
+}
+
 void NTPBackgroundImagesService::MarkThisInstallIsNotSuperReferralForever() {
   local_pref_->Set(prefs::kNewTabPageCachedSuperReferralComponentInfo,
                    base::Value(base::Value::Type::DICTIONARY));
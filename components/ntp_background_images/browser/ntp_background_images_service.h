@@ -68,6 +68,36 @@ class NTPBackgroundImagesService {
 
   std::vector<std::string> GetTopSitesFaviconList() const;
 
+  // Component manifest and its typed form. Both are produced on a background
+  // sequence so that parsing large manifests doesn't block the UI thread.
+  struct ComponentData {
+    ComponentData();
+    ComponentData(ComponentData&& other);
+    ComponentData& operator=(ComponentData&& other);
+    ~ComponentData();
+
+    std::string json_string;
+    std::unique_ptr<NTPBackgroundImagesData> images_data;
+  };
+
+  // Result of looking up the referral promo code in the SR mapping table.
+  struct MappingTableResult {
+    MappingTableResult();
+    MappingTableResult(MappingTableResult&& other);
+    MappingTableResult& operator=(MappingTableResult&& other);
+    ~MappingTableResult();
+
+    bool is_valid = false;
+    // Dictionary value when the promo code is a super referral code.
+    // Otherwise, NONE.
+    base::Value component_info;
+  };
+
+  static ComponentData ParseComponentData(const std::string& json_string,
+                                          const base::FilePath& installed_dir);
+  static MappingTableResult ParseMappingTable(const std::string& json_string,
+                                              const std::string& promo_code);
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -109,11 +139,11 @@ class NTPBackgroundImagesService {
 
   void OnComponentReady(bool is_super_referral,
                         const base::FilePath& installed_dir);
-  void OnGetComponentJsonData(bool is_super_referral,
-                              const std::string& json_string);
+  void OnGetComponentJsonData(bool is_super_referral, ComponentData data);
+  void OnGetCachedSuperReferralData(ComponentData data);
   void OnMappingTableComponentReady(const base::FilePath& installed_dir);
   void OnPreferenceChanged(const std::string& pref_name);
-  void OnGetMappingTableData(const std::string& json_string);
+  void OnGetMappingTableData(MappingTableResult result);
 
   std::string GetReferralPromoCode() const;
   bool IsValidSuperReferralComponentInfo(
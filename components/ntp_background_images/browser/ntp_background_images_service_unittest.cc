@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include "base/strings/stringprintf.h"
 #include "base/test/task_environment.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -77,6 +78,18 @@ class TestNTPBackgroundImagesService : public NTPBackgroundImagesService {
  public:
   using NTPBackgroundImagesService::NTPBackgroundImagesService;
 
+  // Simulates background parsing of component data and mapping table.
+  void OnGetComponentJsonData(bool is_super_referral,
+                              const std::string& json_string) {
+    NTPBackgroundImagesService::OnGetComponentJsonData(
+        is_super_referral, ParseComponentData(json_string, base::FilePath()));
+  }
+
+  void OnGetMappingTableData(const std::string& json_string) {
+    NTPBackgroundImagesService::OnGetMappingTableData(
+        ParseMappingTable(json_string, GetReferralPromoCode()));
+  }
+
   void CheckSuperReferralComponent() override {
     NTPBackgroundImagesService::CheckSuperReferralComponent();
     checked_super_referral_component_ = true;
@@ -334,6 +347,60 @@ TEST_F(NTPBackgroundImagesServiceTest, BasicSuperReferralTest) {
   service_->RemoveObserver(&observer);
 }
 
+TEST_F(NTPBackgroundImagesServiceTest, CachedSuperReferralDataTest) {
+  base::Value component_info(base::Value::Type::DICTIONARY);
+  component_info.SetStringKey(kPublicKey, "ABCDEFGHIJKLMN");
+  component_info.SetStringKey(kComponentIDKey, "abcdefghijklmn");
+  component_info.SetStringKey(kThemeNameKey, "Alphabet software");
+  pref_service_.Set(prefs::kNewTabPageCachedSuperReferralComponentInfo,
+                    component_info);
+  pref_service_.SetString(prefs::kNewTabPageCachedSuperReferralComponentData,
+                          kTestSuperReferral);
+
+  Init();
+  TestObserver observer;
+  service_->AddObserver(&observer);
+  EXPECT_TRUE(service_->super_referral_component_started_);
+
+  // Cached data is parsed on a background sequence.
+  EXPECT_FALSE(service_->GetBackgroundImagesData(true));
+  env_.RunUntilIdle();
+  auto* data = service_->GetBackgroundImagesData(true);
+  ASSERT_TRUE(data);
+  EXPECT_TRUE(data->IsSuperReferral());
+  EXPECT_TRUE(observer.on_updated_);
+  EXPECT_EQ(data, observer.data_);
+
+  service_->RemoveObserver(&observer);
+}
+
+TEST_F(NTPBackgroundImagesServiceTest, ParseMappingTableTest) {
+  auto result = NTPBackgroundImagesService::ParseMappingTable("", "BRV003");
+  EXPECT_FALSE(result.is_valid);
+  result = NTPBackgroundImagesService::ParseMappingTable("[]", "BRV003");
+  EXPECT_FALSE(result.is_valid);
+
+  result = NTPBackgroundImagesService::ParseMappingTable(kTestMappingTable,
+                                                         "BRV002");
+  EXPECT_TRUE(result.is_valid);
+  EXPECT_TRUE(result.component_info.is_none());
+
+  // Only the entry for the given code is extracted from a large table.
+  std::string large_table = "{\"schemaVersion\": 1";
+  for (int i = 0; i < 10000; ++i) {
+    large_table += base::StringPrintf(
+        ",\"CODE%d\": {\"publicKey\": \"key%d\", \"componentID\": \"id%d\","
+        " \"themeName\": \"theme%d\"}",
+        i, i, i, i);
+  }
+  large_table += "}";
+  result = NTPBackgroundImagesService::ParseMappingTable(large_table,
+                                                         "CODE9999");
+  EXPECT_TRUE(result.is_valid);
+  ASSERT_TRUE(result.component_info.is_dict());
+  EXPECT_EQ("id9999", *result.component_info.FindStringKey(kComponentIDKey));
+}
+
 // Test default referral code and first run.
 // Sponsored Images component will be run after promo code set to pref.
 TEST_F(NTPBackgroundImagesServiceTest, WithDefaultReferralCodeTest1) {
@@ -62,7 +62,9 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
           }
         ]
       })";
-  service_->OnGetComponentJsonData(false, test_json_string_referral);
+  service_->OnGetComponentJsonData(
+      false, NTPBackgroundImagesService::ParseComponentData(
+                 test_json_string_referral, base::FilePath()));
   EXPECT_FALSE(source_->AllowCaching());
   EXPECT_TRUE(source_->IsWallpaperPath("sponsored-images/wallpaper-1.jpg"));
   EXPECT_FALSE(source_->IsValidPath("super-duper/brave.png"));
@@ -124,7 +126,9 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicSuperReferralDataTest) {
           }
         ]
       })";
-  service_->OnGetComponentJsonData(true, test_json_string_referral);
+  service_->OnGetComponentJsonData(
+      true, NTPBackgroundImagesService::ParseComponentData(
+                test_json_string_referral, base::FilePath()));
   EXPECT_FALSE(source_->AllowCaching());
   EXPECT_TRUE(source_->IsTopSiteFaviconPath("super-referral/bat.png"));
   EXPECT_FALSE(source_->IsTopSiteFaviconPath("super-referral/logo.png"));
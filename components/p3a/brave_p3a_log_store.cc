@@ -5,11 +5,16 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -34,6 +39,11 @@ void RecordP3A(uint64_t answers_count) {
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.P3A.SentAnswersCount", answer, 3);
 }
 
+bool IsP2AMetric(base::StringPiece histogram_name) {
+  return base::StartsWith(histogram_name, "Brave.P2A",
+                          base::CompareCase::SENSITIVE);
+}
+
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
@@ -49,33 +59,63 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
 }
 
-void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
+void BraveP3ALogStore::SetMaxBatchSize(size_t max_batch_size) {
+  DCHECK_GE(max_batch_size, 1u);
+  DCHECK(!has_staged_log());
+  max_batch_size_ = max_batch_size;
+}
+
+bool BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
+  auto iter = log_.find(histogram_name);
+  if (iter != log_.end() && iter->second.value == value) {
+    return false;
+  }
+  if (iter == log_.end()) {
+    iter = log_.emplace(histogram_name, LogEntry()).first;
+  }
+
+  LogEntry& entry = iter->second;
   entry.value = value;
   if (!entry.sent) {
     DCHECK(entry.sent_timestamp.is_null());
     unsent_entries_.insert(histogram_name);
   }
+  dirty_entries_.insert(histogram_name);
+  return true;
+}
 
-  // Update the persistent value.
+void BraveP3ALogStore::PersistValues() {
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  // Update the persistent values.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  for (const auto& histogram_name : dirty_entries_) {
+    auto iter = log_.find(histogram_name);
+    DCHECK(iter != log_.end());
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(iter->second.value)));
+    update->SetPath({histogram_name, kLogSentKey},
+                    base::Value(iter->second.sent));
+  }
+  dirty_entries_.clear();
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
+  dirty_entries_.erase(histogram_name);
 
   // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
   update->RemovePath(histogram_name);
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
+  // Drop the whole batch, the remaining values will be staged again.
+  if (base::Contains(staged_entry_keys_, histogram_name)) {
+    staged_entry_keys_.clear();
     staged_log_.clear();
   }
 }
@@ -111,24 +151,18 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
+  DCHECK(has_staged_log());
   return staged_log_;
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
+  DCHECK(has_staged_log());
+  // All values of a batch are of the same type.
+  if (IsP2AMetric(staged_entry_keys_.front())) {
     return "p2a";
   }
   return "p3a";
@@ -148,13 +182,33 @@ void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
   uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  staged_entry_keys_ = PickBatch(*(unsent_entries_.begin() + rand_idx));
+
+  if (!is_batching_enabled()) {
+    const std::string& staged_entry_key = staged_entry_keys_.front();
+    DCHECK(!log_.find(staged_entry_key)->second.sent);
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+    uint64_t staged_entry_value = log_[staged_entry_key].value;
+    staged_log_ = delegate_->Serialize(staged_entry_key, staged_entry_value);
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+    VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key;
+    return;
+  }
+
+  // Every value is serialized on its own, so the envelope doesn't add
+  // anything that links them besides being sent together.
+  brave_pyxis::RawP3ABatch batch;
+  for (const auto& staged_entry_key : staged_entry_keys_) {
+    auto iter = log_.find(staged_entry_key);
+    DCHECK(iter != log_.end());
+    DCHECK(!iter->second.sent);
+    batch.add_values(delegate_->Serialize(staged_entry_key,
+                                          iter->second.value));
+  }
+  staged_log_ = batch.SerializeAsString();
+
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged "
+          << staged_entry_keys_.size() << " values";
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -162,29 +216,59 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  for (const auto& staged_entry_key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(staged_entry_key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+
+    // Update the persistent value.
+    update->SetPath({log_iter->first, kLogSentKey},
+                    base::Value(log_iter->second.sent));
+    update->SetPath({log_iter->first, kLogTimestampKey},
+                    base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(staged_entry_key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
 
-  staged_entry_key_.clear();
+  staged_entry_keys_.clear();
   staged_log_.clear();
 }
 
 void BraveP3ALogStore::MarkStagedLogAsSent() {}
 
+std::vector<std::string> BraveP3ALogStore::PickBatch(
+    const std::string& first_key) const {
+  std::vector<std::string> batch = {first_key};
+  if (!is_batching_enabled()) {
+    return batch;
+  }
+
+  // P3A and P2A values go to different endpoints.
+  const bool is_p2a = IsP2AMetric(first_key);
+  std::vector<const std::string*> candidates;
+  for (const auto& key : unsent_entries_) {
+    if (key != first_key && IsP2AMetric(key) == is_p2a) {
+      candidates.push_back(&key);
+    }
+  }
+
+  // Partial Fisher-Yates shuffle.
+  const size_t count = std::min(candidates.size(), max_batch_size_ - 1);
+  for (size_t i = 0; i < count; i++) {
+    const size_t j = i + base::RandGenerator(candidates.size() - i);
+    std::swap(candidates[i], candidates[j]);
+    batch.push_back(*candidates[i]);
+  }
+  // The first value shouldn't stand out either.
+  std::swap(batch.front(), batch[base::RandGenerator(batch.size())]);
+  return batch;
+}
+
 void BraveP3ALogStore::TrimAndPersistUnsentLogs() {
   NOTREACHED();
 }
@@ -6,7 +6,10 @@
 #ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
+#include <stddef.h>
+
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -19,7 +22,11 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists in prefs on the fly, except
+// for value updates which are persisted in batches by |PersistValues|.
+// With a batch size above 1, several unsent values of the same type are staged
+// together and wrapped into a |brave_pyxis::RawP3ABatch| envelope in random
+// order.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -43,7 +50,16 @@ class BraveP3ALogStore : public metrics::LogStore {
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
-  void UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Sets the maximum number of values staged for a single upload. 1 (the
+  // default) stages a single serialized value without an envelope.
+  void SetMaxBatchSize(size_t max_batch_size);
+  bool is_batching_enabled() const { return max_batch_size_ > 1; }
+
+  // Returns false if the value is already known, in which case nothing needs
+  // to be persisted. Otherwise the value is persisted by |PersistValues|.
+  bool UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Writes updated values to prefs with a single update.
+  void PersistValues();
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
   // Marks all saved values as unsent.
@@ -54,6 +70,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   bool has_staged_log() const override;
   const std::string& staged_log() const override;
   std::string staged_log_type() const;
+  // Number of values in the staged log.
+  size_t staged_entry_count() const { return staged_entry_keys_.size(); }
   const std::string& staged_log_hash() const override;
   const std::string& staged_log_signature() const override;
   void StageNextLog() override;
@@ -90,8 +108,16 @@ class BraveP3ALogStore : public metrics::LogStore {
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
+  // Entries with values not persisted yet.
+  base::flat_set<std::string> dirty_entries_;
+
+  // Picks the rest of the batch among unsent entries of the same type as
+  // |first_key|.
+  std::vector<std::string> PickBatch(const std::string& first_key) const;
+
+  size_t max_batch_size_ = 1u;
 
-  std::string staged_entry_key_;
+  std::vector<std::string> staged_entry_keys_;
   std::string staged_log_;
 
   // Not used for now.
@@ -0,0 +1,165 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "brave/components/brave_prochlo/prochlo_message.pb.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3ALogStore*
+
+namespace brave {
+
+namespace {
+
+constexpr const char* kP3AHistogramNames[] = {
+    "Brave.Test.First",
+    "Brave.Test.Second",
+    "Brave.Test.Third",
+};
+
+constexpr char kP2AHistogramName[] = "Brave.P2A.Test";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  // Serializes to "<name>=<value>" so tests can tell the values apart.
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return histogram_name.as_string() + "=" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return base::StartsWith(histogram_name, "Brave.",
+                            base::CompareCase::SENSITIVE);
+  }
+};
+
+}  // namespace
+
+class P3ALogStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store_->LoadPersistedUnsentLogs();
+
+    uint64_t value = 1;
+    for (const char* histogram_name : kP3AHistogramNames) {
+      log_store_->UpdateValue(histogram_name, value++);
+    }
+    log_store_->UpdateValue(kP2AHistogramName, value);
+    log_store_->PersistValues();
+  }
+
+  std::set<std::string> ParseStagedBatch() {
+    brave_pyxis::RawP3ABatch batch;
+    EXPECT_TRUE(batch.ParseFromString(log_store_->staged_log()));
+    return std::set<std::string>(batch.values().begin(), batch.values().end());
+  }
+
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+};
+
+TEST_F(P3ALogStoreTest, StagesSingleValueByDefault) {
+  // Arrange
+
+  // Act
+  log_store_->StageNextLog();
+
+  // Assert
+  EXPECT_EQ(1u, log_store_->staged_entry_count());
+  EXPECT_NE(std::string::npos, log_store_->staged_log().find('='));
+}
+
+TEST_F(P3ALogStoreTest, StagesBatchOfSameType) {
+  // Arrange
+  log_store_->SetMaxBatchSize(10);
+
+  // Act
+  std::set<std::string> p3a_values;
+  std::set<std::string> p2a_values;
+  while (log_store_->has_unsent_logs()) {
+    log_store_->StageNextLog();
+    const std::set<std::string> values = ParseStagedBatch();
+    EXPECT_EQ(values.size(), log_store_->staged_entry_count());
+    if (log_store_->staged_log_type() == "p2a") {
+      p2a_values.insert(values.begin(), values.end());
+    } else {
+      p3a_values.insert(values.begin(), values.end());
+    }
+    log_store_->DiscardStagedLog();
+  }
+
+  // Assert
+  EXPECT_EQ((std::set<std::string>{"Brave.Test.First=1", "Brave.Test.Second=2",
+                                   "Brave.Test.Third=3"}),
+            p3a_values);
+  EXPECT_EQ((std::set<std::string>{"Brave.P2A.Test=4"}), p2a_values);
+}
+
+TEST_F(P3ALogStoreTest, LimitsBatchSize) {
+  // Arrange
+  log_store_->SetMaxBatchSize(2);
+
+  // Act
+  size_t upload_count = 0;
+  while (log_store_->has_unsent_logs()) {
+    log_store_->StageNextLog();
+    EXPECT_LE(log_store_->staged_entry_count(), 2u);
+    log_store_->DiscardStagedLog();
+    upload_count++;
+  }
+
+  // Assert
+  // Three P3A values need at least two uploads, plus one for P2A.
+  EXPECT_LE(3u, upload_count);
+  EXPECT_GE(4u, upload_count);
+}
+
+TEST_F(P3ALogStoreTest, RemovingValueUnstagesBatch) {
+  // Arrange
+  log_store_->SetMaxBatchSize(10);
+  do {
+    log_store_->StageNextLog();
+  } while (log_store_->staged_log_type() != "p3a");
+
+  // Act
+  log_store_->RemoveValueIfExists("Brave.Test.Second");
+
+  // Assert
+  EXPECT_FALSE(log_store_->has_staged_log());
+  log_store_->StageNextLog();
+  if (log_store_->staged_log_type() == "p3a") {
+    EXPECT_EQ((std::set<std::string>{"Brave.Test.First=1",
+                                     "Brave.Test.Third=3"}),
+              ParseStagedBatch());
+  }
+}
+
+TEST_F(P3ALogStoreTest, ResetUploadStampsMakesBatchedValuesUnsent) {
+  // Arrange
+  log_store_->SetMaxBatchSize(10);
+  while (log_store_->has_unsent_logs()) {
+    log_store_->StageNextLog();
+    log_store_->DiscardStagedLog();
+  }
+
+  // Act
+  log_store_->ResetUploadStamps();
+
+  // Assert
+  EXPECT_TRUE(log_store_->has_unsent_logs());
+}
+
+}  // namespace brave
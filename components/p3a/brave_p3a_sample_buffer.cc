@@ -0,0 +1,147 @@
+/* Copyright 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_sample_buffer.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/metrics/statistics_recorder.h"
+
+namespace brave {
+
+namespace {
+
+const base::BucketRanges* FindBucketRanges(const char* histogram_name) {
+  const base::HistogramBase* histogram =
+      base::StatisticsRecorder::FindHistogram(histogram_name);
+  if (!histogram)
+    return nullptr;
+
+  switch (histogram->GetHistogramType()) {
+    case base::HISTOGRAM:
+    case base::LINEAR_HISTOGRAM:
+    case base::BOOLEAN_HISTOGRAM:
+    case base::CUSTOM_HISTOGRAM:
+      return static_cast<const base::Histogram*>(histogram)->bucket_ranges();
+    default:
+      return nullptr;
+  }
+}
+
+// Mirrors |base::SampleVector::GetBucketIndex|.
+size_t GetBucketIndex(const base::BucketRanges& ranges,
+                      base::HistogramBase::Sample sample) {
+  size_t under = 0;
+  size_t over = ranges.bucket_count();
+  do {
+    const size_t mid = under + (over - under) / 2;
+    if (ranges.range(mid) <= sample) {
+      under = mid;
+    } else {
+      over = mid;
+    }
+  } while (over - under > 1);
+  return under;
+}
+
+}  // namespace
+
+BraveP3ASampleBuffer::BraveP3ASampleBuffer(
+    base::span<const char* const> histogram_names)
+    : slots_(new Slot[histogram_names.size()]),
+      slot_count_(histogram_names.size()) {
+  std::vector<std::pair<uint64_t, size_t>> slot_by_name_hash;
+  for (size_t i = 0; i < histogram_names.size(); i++) {
+    slots_[i].histogram_name = histogram_names[i];
+    slot_by_name_hash.emplace_back(base::HashMetricName(histogram_names[i]),
+                                   i);
+  }
+  slot_by_name_hash_ =
+      base::flat_map<uint64_t, size_t>(std::move(slot_by_name_hash));
+}
+
+BraveP3ASampleBuffer::~BraveP3ASampleBuffer() = default;
+
+bool BraveP3ASampleBuffer::Record(uint64_t name_hash,
+                                  const char* histogram_name,
+                                  base::HistogramBase::Sample sample) {
+  Slot* slot = FindSlot(name_hash);
+  if (!slot)
+    return false;
+
+  const base::BucketRanges* ranges =
+      slot->bucket_ranges.load(std::memory_order_acquire);
+  if (!ranges) {
+    ranges = FindBucketRanges(histogram_name);
+    if (!ranges) {
+      LOG(ERROR) << "Only linear histograms are supported at the moment!";
+      NOTREACHED();
+      return false;
+    }
+    slot->bucket_ranges.store(ranges, std::memory_order_release);
+  }
+
+  // Note that we store only buckets, not actual values.
+  return Store(slot, GetBucketIndex(*ranges, sample));
+}
+
+bool BraveP3ASampleBuffer::RecordBucket(uint64_t name_hash, uint64_t bucket) {
+  Slot* slot = FindSlot(name_hash);
+  if (!slot)
+    return false;
+  return Store(slot, bucket);
+}
+
+std::vector<BraveP3ASampleBuffer::PendingSample> BraveP3ASampleBuffer::Take() {
+  // Reset the request first, so that a sample recorded while we are scanning
+  // schedules another flush rather than being left behind.
+  flush_requested_.store(false, std::memory_order_release);
+
+  std::vector<PendingSample> samples;
+  for (size_t i = 0; i < slot_count_; i++) {
+    Slot& slot = slots_[i];
+    const uint64_t pending =
+        slot.pending.exchange(0u, std::memory_order_acq_rel);
+    if (pending == 0u)
+      continue;
+
+    PendingSample sample;
+    sample.histogram_name = slot.histogram_name;
+    sample.bucket = pending - 1;
+    if (const base::BucketRanges* ranges =
+            slot.bucket_ranges.load(std::memory_order_acquire)) {
+      sample.bucket_count = ranges->bucket_count();
+    }
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+BraveP3ASampleBuffer::Slot* BraveP3ASampleBuffer::FindSlot(
+    uint64_t name_hash) {
+  const auto it = slot_by_name_hash_.find(name_hash);
+  if (it == slot_by_name_hash_.end())
+    return nullptr;
+  return &slots_[it->second];
+}
+
+bool BraveP3ASampleBuffer::Store(Slot* slot, uint64_t bucket) {
+  DCHECK(slot);
+  const uint64_t previous =
+      slot->pending.exchange(bucket + 1, std::memory_order_acq_rel);
+  if (previous != 0u)
+    coalesced_count_.fetch_add(1, std::memory_order_relaxed);
+
+  // Only the first sample since the last flush needs to schedule one
+  if (flush_requested_.load(std::memory_order_acquire))
+    return false;
+  return !flush_requested_.exchange(true, std::memory_order_acq_rel);
+}
+
+}  // namespace brave
@@ -0,0 +1,88 @@
+/* Copyright 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_SAMPLE_BUFFER_H_
+#define BRAVE_COMPONENTS_P3A_BRAVE_P3A_SAMPLE_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "base/metrics/histogram_base.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class BucketRanges;
+}  // namespace base
+
+namespace brave {
+
+// Keeps the latest bucket of every collected histogram until the next flush,
+// so that bursts of samples turn into a single log store update.
+// |Record*| may be called on any thread and doesn't lock or allocate; |Take|
+// is expected to be called on a single sequence.
+class BraveP3ASampleBuffer {
+ public:
+  struct PendingSample {
+    base::StringPiece histogram_name;
+    uint64_t bucket = 0u;
+    // Number of buckets of the histogram, 0 if unknown.
+    size_t bucket_count = 0u;
+  };
+
+  explicit BraveP3ASampleBuffer(base::span<const char* const> histogram_names);
+  ~BraveP3ASampleBuffer();
+
+  BraveP3ASampleBuffer(const BraveP3ASampleBuffer&) = delete;
+  BraveP3ASampleBuffer& operator=(const BraveP3ASampleBuffer&) = delete;
+
+  // Records the bucket |sample| falls in. Returns true if the caller should
+  // schedule a flush, i.e. this is the first sample since the last |Take|.
+  // Returns false and drops the sample if the histogram isn't tracked or
+  // isn't bucketed by |base::BucketRanges|.
+  bool Record(uint64_t name_hash,
+              const char* histogram_name,
+              base::HistogramBase::Sample sample);
+  // Same as |Record|, but for an already known bucket.
+  bool RecordBucket(uint64_t name_hash, uint64_t bucket);
+
+  // Returns and clears the pending buckets.
+  std::vector<PendingSample> Take();
+
+  // Number of samples which replaced a pending bucket instead of producing
+  // a separate update.
+  uint64_t coalesced_count() const {
+    return coalesced_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    base::StringPiece histogram_name;
+    // Pending bucket + 1, or 0 if there is none.
+    std::atomic<uint64_t> pending{0u};
+    // Cached on first use, bucket ranges outlive the histograms.
+    std::atomic<const base::BucketRanges*> bucket_ranges{nullptr};
+  };
+
+  Slot* FindSlot(uint64_t name_hash);
+  bool Store(Slot* slot, uint64_t bucket);
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t slot_count_ = 0u;
+  // Immutable after construction, so lookups are thread-safe.
+  base::flat_map<uint64_t, size_t> slot_by_name_hash_;
+
+  std::atomic<bool> flush_requested_{false};
+  std::atomic<uint64_t> coalesced_count_{0u};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_P3A_BRAVE_P3A_SAMPLE_BUFFER_H_
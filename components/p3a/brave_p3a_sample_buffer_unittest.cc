@@ -0,0 +1,126 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_sample_buffer.h"
+
+#include <limits.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/metrics/histogram.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/metrics/statistics_recorder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3ASampleBuffer*
+
+namespace brave {
+
+namespace {
+
+constexpr const char* kHistogramNames[] = {
+    "Brave.Test.First",
+    "Brave.Test.Second",
+};
+
+}  // namespace
+
+class P3ASampleBufferTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    recorder_ = base::StatisticsRecorder::CreateTemporaryForTesting();
+    for (const char* histogram_name : kHistogramNames) {
+      base::LinearHistogram::FactoryGet(histogram_name, 1, 4, 5,
+                                        base::HistogramBase::kNoFlags);
+    }
+  }
+
+  bool Record(const char* histogram_name, int sample) {
+    return buffer_.Record(base::HashMetricName(histogram_name), histogram_name,
+                          sample);
+  }
+
+  std::unique_ptr<base::StatisticsRecorder> recorder_;
+  BraveP3ASampleBuffer buffer_{kHistogramNames};
+};
+
+TEST_F(P3ASampleBufferTest, CoalescesSamples) {
+  // Arrange
+
+  // Act
+  EXPECT_TRUE(Record("Brave.Test.First", 1));
+  EXPECT_FALSE(Record("Brave.Test.First", 2));
+  EXPECT_FALSE(Record("Brave.Test.First", 3));
+  EXPECT_FALSE(Record("Brave.Test.Second", 0));
+
+  const std::vector<BraveP3ASampleBuffer::PendingSample> samples =
+      buffer_.Take();
+
+  // Assert
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ("Brave.Test.First", samples[0].histogram_name);
+  EXPECT_EQ(3u, samples[0].bucket);
+  EXPECT_EQ(5u, samples[0].bucket_count);
+  EXPECT_EQ("Brave.Test.Second", samples[1].histogram_name);
+  EXPECT_EQ(0u, samples[1].bucket);
+  EXPECT_EQ(2u, buffer_.coalesced_count());
+}
+
+TEST_F(P3ASampleBufferTest, RequestsFlushAfterTake) {
+  // Arrange
+  EXPECT_TRUE(Record("Brave.Test.First", 1));
+  buffer_.Take();
+
+  // Act
+  const bool should_flush = Record("Brave.Test.First", 1);
+
+  // Assert
+  EXPECT_TRUE(should_flush);
+  EXPECT_EQ(1u, buffer_.Take().size());
+  EXPECT_TRUE(buffer_.Take().empty());
+}
+
+TEST_F(P3ASampleBufferTest, MapsSamplesToBuckets) {
+  // Arrange
+
+  // Act
+  Record("Brave.Test.First", 100);
+
+  // Assert
+  const auto samples = buffer_.Take();
+  ASSERT_EQ(1u, samples.size());
+  // Overflow bucket
+  EXPECT_EQ(4u, samples[0].bucket);
+}
+
+TEST_F(P3ASampleBufferTest, RecordsKnownBucket) {
+  // Arrange
+  constexpr uint64_t kBucket = INT_MAX - 1;
+
+  // Act
+  EXPECT_TRUE(buffer_.RecordBucket(base::HashMetricName("Brave.Test.Second"),
+                                   kBucket));
+
+  // Assert
+  const auto samples = buffer_.Take();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ(kBucket, samples[0].bucket);
+}
+
+TEST_F(P3ASampleBufferTest, IgnoresUnknownHistograms) {
+  // Arrange
+  base::LinearHistogram::FactoryGet("Brave.Test.Unknown", 1, 4, 5,
+                                    base::HistogramBase::kNoFlags);
+
+  // Act
+  const bool should_flush = Record("Brave.Test.Unknown", 1);
+
+  // Assert
+  EXPECT_FALSE(should_flush);
+  EXPECT_TRUE(buffer_.Take().empty());
+}
+
+}  // namespace brave
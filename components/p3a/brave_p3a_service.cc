@@ -7,13 +7,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/i18n/timezone.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/metrics/histogram_samples.h"
 #include "base/metrics/metrics_hashes.h"
-#include "base/metrics/sample_vector.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/no_destructor.h"
 #include "base/rand_util.h"
@@ -56,6 +55,10 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Delay for coalescing histogram samples before they are written to the log
+// store and local state.
+constexpr base::TimeDelta kSampleFlushDelay = base::TimeDelta::FromSeconds(5);
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -194,7 +197,7 @@ base::TimeDelta TimeDeltaTillMonday(base::Time time) {
 }  // namespace
 
 BraveP3AService::BraveP3AService(PrefService* local_state)
-    : local_state_(local_state) {}
+    : local_state_(local_state), sample_buffer_(kCollectedHistograms) {}
 
 BraveP3AService::~BraveP3AService() = default;
 
@@ -232,18 +235,17 @@ void BraveP3AService::Init(
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
           << ", upload_server_url_ = " << upload_server_url_.spec()
+          << ", upload_batch_size_ = " << upload_batch_size_
           << ", rotation_interval_ = " << rotation_interval_;
 
   InitPyxisMeta();
 
   // Init log store.
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
+  log_store_->SetMaxBatchSize(upload_batch_size_);
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(entry.first.as_string(), entry.second);
-  }
-  histogram_values_ = {};
+  FlushSamples();
   // Do rotation if needed.
   const base::Time last_rotation =
       local_state_->GetTime(kLastRotationTimeStampPref);
@@ -261,6 +263,7 @@ void BraveP3AService::Init(
   // Init other components.
   uploader_.reset(new BraveP3AUploader(
       url_loader_factory, upload_server_url_, GURL(kP2AServerUrl),
+      log_store_->is_batching_enabled(),
       base::Bind(&BraveP3AService::OnLogUploadComplete, this)));
 
   upload_scheduler_.reset(new BraveP3AScheduler(
@@ -338,6 +341,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
       upload_server_url_ = url;
     }
   }
+
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string batch_size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t batch_size;
+    if (base::StringToSizeT(batch_size_str, &batch_size) && batch_size > 0) {
+      upload_batch_size_ = batch_size;
+    }
+  }
 }
 
 void BraveP3AService::InitPyxisMeta() {
@@ -394,6 +406,10 @@ void BraveP3AService::StartScheduledUpload() {
     const std::string log_type = log_store_->staged_log_type();
     VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
             << "of type " << log_type;
+    rotation_upload_count_++;
+    rotation_uploaded_values_ += log_store_->staged_entry_count();
+    // The body is sent base64-encoded.
+    rotation_uploaded_bytes_ += (log.size() + 2) / 3 * 4;
     uploader_->UploadLog(log, log_type);
   }
 }
@@ -401,72 +417,91 @@ void BraveP3AService::StartScheduledUpload() {
 void BraveP3AService::OnHistogramChanged(const char* histogram_name,
                                          uint64_t name_hash,
                                          base::HistogramBase::Sample sample) {
-  std::unique_ptr<base::HistogramSamples> samples =
-      base::StatisticsRecorder::FindHistogram(histogram_name)->SnapshotDelta();
-  DCHECK(!samples->Iterator()->Done());
-
+  bool should_schedule_flush = false;
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
+    should_schedule_flush =
+        sample_buffer_.RecordBucket(name_hash, kSuspendedMetricBucket);
+  } else {
+    should_schedule_flush =
+        sample_buffer_.Record(name_hash, histogram_name, sample);
+  }
+
+  if (should_schedule_flush) {
     base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+                   base::BindOnce(&BraveP3AService::ScheduleSampleFlushOnUI,
+                                  this));
+  }
+}
+
+void BraveP3AService::OnShutdown() {
+  if (!initialized_) {
     return;
   }
+  FlushSamples();
+}
 
-  // Note that we store only buckets, not actual values.
-  size_t bucket = 0u;
-  const bool ok = samples->Iterator()->GetBucketIndex(&bucket);
-  if (!ok) {
-    LOG(ERROR) << "Only linear histograms are supported at the moment!";
-    NOTREACHED();
+void BraveP3AService::ScheduleSampleFlushOnUI() {
+  if (!initialized_) {
+    // Will handle it later when ready.
     return;
   }
+  if (!sample_flush_timer_.IsRunning()) {
+    sample_flush_timer_.Start(FROM_HERE, kSampleFlushDelay, this,
+                              &BraveP3AService::FlushSamples);
+  }
+}
 
-  // Special handling of P2A histograms.
-  if (base::StartsWith(histogram_name, "Brave.P2A.",
-                       base::CompareCase::SENSITIVE)) {
-    // We need the bucket count to make proper perturbation.
-    // All P2A metrics should be implemented as linear histograms.
-    base::SampleVector* vector =
-        static_cast<base::SampleVector*>(samples.get());
-    DCHECK(vector);
-    const size_t bucket_count = vector->bucket_ranges()->bucket_count() - 1;
-    VLOG(2) << "P2A metric " << histogram_name << " has bucket count "
-            << bucket_count;
-
-    // Perturb the bucket.
-    bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
+void BraveP3AService::FlushSamples() {
+  DCHECK(initialized_);
+  sample_flush_timer_.Stop();
+
+  const std::vector<BraveP3ASampleBuffer::PendingSample> samples =
+      sample_buffer_.Take();
+  if (samples.empty()) {
+    return;
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
-}
+  for (const auto& sample : samples) {
+    uint64_t bucket = sample.bucket;
+    VLOG(2) << "BraveP3AService::FlushSamples: histogram_name = "
+            << sample.histogram_name << " bucket = " << bucket;
+
+    // Special handling of P2A histograms.
+    if (!IsSuspendedMetric(sample.histogram_name, bucket) &&
+        base::StartsWith(sample.histogram_name, "Brave.P2A.",
+                         base::CompareCase::SENSITIVE)) {
+      // We need the bucket count to make proper perturbation.
+      // All P2A metrics should be implemented as linear histograms.
+      DCHECK_GT(sample.bucket_count, 0u);
+      const size_t bucket_count = sample.bucket_count - 1;
+      VLOG(2) << "P2A metric " << sample.histogram_name
+              << " has bucket count " << bucket_count;
+
+      // Perturb the bucket.
+      bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
+    }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
-  if (!initialized_) {
-    // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+    if (!HandleHistogramChange(sample.histogram_name, bucket)) {
+      skipped_log_updates_++;
+    }
   }
+  log_store_->PersistValues();
+
+  VLOG(2) << "BraveP3AService::FlushSamples: flushed " << samples.size()
+          << " metrics, " << sample_buffer_.coalesced_count()
+          << " samples coalesced and " << skipped_log_updates_
+          << " unchanged values skipped so far";
 }
 
-void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
+bool BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
                                             size_t bucket) {
   if (IsSuspendedMetric(histogram_name, bucket)) {
     log_store_->RemoveValueIfExists(histogram_name.as_string());
-    return;
+    return true;
   }
-  log_store_->UpdateValue(histogram_name.as_string(), bucket);
+  return log_store_->UpdateValue(histogram_name.as_string(), bucket);
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
@@ -488,6 +523,15 @@ void BraveP3AService::OnLogUploadComplete(int response_code,
 
 void BraveP3AService::DoRotation() {
   VLOG(2) << "BraveP3AService doing rotation at " << base::Time::Now();
+  VLOG(2) << "BraveP3AService previous rotation sent "
+          << rotation_uploaded_values_ << " values in "
+          << rotation_upload_count_ << " requests, "
+          << rotation_uploaded_bytes_ << " bytes of request bodies";
+  rotation_upload_count_ = 0u;
+  rotation_uploaded_values_ = 0u;
+  rotation_uploaded_bytes_ = 0u;
+  // Make sure the values being rotated are up to date.
+  FlushSamples();
   log_store_->ResetUploadStamps();
   UpdateRotationTimer();
 
@@ -15,6 +15,7 @@
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
+#include "brave/components/p3a/brave_p3a_sample_buffer.h"
 #include "url/gurl.h"
 
 class PrefRegistrySimple;
@@ -47,6 +48,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes the buffered samples to local state. Must be called on the UI
+  // thread before local state is committed at shutdown.
+  void OnShutdown();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) override;
@@ -68,17 +73,20 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method only buffers the sample and asks the
+  // UI thread to flush the buffer soon.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  void ScheduleSampleFlushOnUI();
+
+  // Moves buffered samples into the log store and persists them.
+  void FlushSamples();
 
-  // Updates or removes a metric from the log.
-  void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
+  // Updates or removes a metric from the log. Returns false if the log
+  // already has this value.
+  bool HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -97,6 +105,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // Interval between rotations, only used for testing from the command line.
   base::TimeDelta rotation_interval_;
   GURL upload_server_url_;
+  // Maximum number of values per upload, see |BraveP3ALogStore|.
+  size_t upload_batch_size_ = 1u;
 
   prochlo::MessageMetainfo pyxis_meta_;
 
@@ -105,9 +115,19 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   std::unique_ptr<BraveP3AUploader> uploader_;
   std::unique_ptr<BraveP3AScheduler> upload_scheduler_;
 
-  // Used to store histogram values that are produced between constructing
-  // the service and its initialization.
-  base::flat_map<base::StringPiece, size_t> histogram_values_;
+  // Latest buckets of histograms recorded since the last flush. Also keeps
+  // values that are produced between constructing the service and its
+  // initialization.
+  BraveP3ASampleBuffer sample_buffer_;
+  base::OneShotTimer sample_flush_timer_;
+  // Log store updates (and prefs writes) saved by coalescing samples, for
+  // diagnostics.
+  uint64_t skipped_log_updates_ = 0u;
+
+  // Upload traffic since the last rotation, for diagnostics.
+  size_t rotation_upload_count_ = 0u;
+  size_t rotation_uploaded_values_ = 0u;
+  size_t rotation_uploaded_bytes_ = 0u;
 
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
@@ -26,6 +26,10 @@ constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 // continue the normal process.
 constexpr char kP3AIgnoreServerErrors[] = "p3a-ignore-server-errors";
 
+// Maximum number of values sent in a single upload. Values above 1 switch
+// uploads to the batched envelope.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 }  // namespace switches
 }  // namespace brave
 
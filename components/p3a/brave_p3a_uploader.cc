@@ -71,10 +71,12 @@ BraveP3AUploader::BraveP3AUploader(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
     const GURL& p3a_endpoint,
     const GURL& p2a_endpoint,
+    bool is_batched,
     const UploadCallback& on_upload_complete)
     : url_loader_factory_(url_loader_factory),
       p3a_endpoint_(p3a_endpoint),
       p2a_endpoint_(p2a_endpoint),
+      is_batched_(is_batched),
       on_upload_complete_(on_upload_complete) {}
 
 BraveP3AUploader::~BraveP3AUploader() = default;
@@ -91,6 +93,9 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   } else {
     NOTREACHED();
   }
+  if (is_batched_) {
+    resource_request->headers.SetHeader("X-Brave-P3A-Batch", "?1");
+  }
 
   resource_request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   resource_request->method = "POST";
@@ -0,0 +1,158 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2021 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""
+Local P3A collector for end-to-end checks of the uploader. Accepts the same
+requests as the P3A backend, decodes single RawP3AValue messages as well as
+RawP3ABatch envelopes and prints request, value and byte counts per rotation.
+
+A rotation is considered finished once a metric shows up again.
+
+Usage:
+    p3a_test_collector.py --port 8080
+
+    brave --p3a-upload-server-url=http://localhost:8080/ \
+        --p3a-upload-interval-seconds=5 --p3a-rotation-interval-seconds=60 \
+        [--p3a-upload-batch-size=10]
+"""
+
+import argparse
+import base64
+import sys
+
+try:
+    from http.server import BaseHTTPRequestHandler, HTTPServer
+except ImportError:
+    from BaseHTTPServer import BaseHTTPRequestHandler, HTTPServer
+
+WIRE_TYPE_VARINT = 0
+WIRE_TYPE_FIXED64 = 1
+WIRE_TYPE_LENGTH_DELIMITED = 2
+WIRE_TYPE_FIXED32 = 5
+
+
+def read_varint(data, pos):
+  result = 0
+  shift = 0
+  while True:
+    byte = bytearray(data[pos:pos + 1])[0]
+    pos += 1
+    result |= (byte & 0x7f) << shift
+    if not byte & 0x80:
+      return result, pos
+    shift += 7
+
+
+def parse_fields(data):
+  """Yields (field number, value) pairs of a serialized protobuf message."""
+  pos = 0
+  while pos < len(data):
+    key, pos = read_varint(data, pos)
+    field, wire_type = key >> 3, key & 0x7
+    if wire_type == WIRE_TYPE_VARINT:
+      value, pos = read_varint(data, pos)
+    elif wire_type == WIRE_TYPE_FIXED64:
+      value = data[pos:pos + 8]
+      pos += 8
+    elif wire_type == WIRE_TYPE_LENGTH_DELIMITED:
+      length, pos = read_varint(data, pos)
+      value = data[pos:pos + length]
+      pos += length
+    elif wire_type == WIRE_TYPE_FIXED32:
+      value = data[pos:pos + 4]
+      pos += 4
+    else:
+      raise ValueError('Unsupported wire type %d' % wire_type)
+    if pos > len(data):
+      raise ValueError('Truncated message')
+    yield field, value
+
+
+def parse_metric_id(raw_value):
+  """Returns the metric id of a serialized RawP3AValue."""
+  for field, value in parse_fields(raw_value):
+    if field == 1:
+      return ''.join('%02x' % b for b in bytearray(reversed(value)))
+  raise ValueError('RawP3AValue without a metric id')
+
+
+class RotationStats(object):
+  def __init__(self):
+    self.reset()
+
+  def reset(self):
+    self.requests = 0
+    self.values = 0
+    self.bytes = 0
+    self.metric_ids = set()
+
+  def report(self, reason):
+    if not self.requests:
+      return
+    print('[%s] %d requests, %d values, %d bytes (%.1f values/request)' %
+          (reason, self.requests, self.values, self.bytes,
+           float(self.values) / self.requests))
+    sys.stdout.flush()
+
+
+STATS = RotationStats()
+
+
+class CollectorHandler(BaseHTTPRequestHandler):
+  def do_POST(self):
+    body = self.rfile.read(int(self.headers.get('Content-Length', 0)))
+    try:
+      data = base64.b64decode(body)
+      if self.headers.get('X-Brave-P3A-Batch'):
+        raw_values = [value for field, value in parse_fields(data)
+                      if field == 1]
+      else:
+        raw_values = [data]
+      metric_ids = [parse_metric_id(raw_value) for raw_value in raw_values]
+    except (TypeError, ValueError) as e:
+      print('Malformed request: %s' % e)
+      self.send_response(400)
+      self.end_headers()
+      return
+
+    if STATS.metric_ids.intersection(metric_ids):
+      STATS.report('rotation')
+      STATS.reset()
+
+    STATS.requests += 1
+    STATS.values += len(raw_values)
+    STATS.bytes += len(body)
+    STATS.metric_ids.update(metric_ids)
+    upload_type = 'p2a' if self.headers.get('X-Brave-P2A') else 'p3a'
+    print('%s request: %d bytes, metrics %s' %
+          (upload_type, len(body), ', '.join(metric_ids)))
+    sys.stdout.flush()
+
+    self.send_response(200)
+    self.end_headers()
+
+  def log_message(self, format, *args):
+    pass
+
+
+def main(args):
+  parser = argparse.ArgumentParser(description='Local P3A collector')
+  parser.add_argument('--port', type=int, default=8080,
+                      help='Port to listen on')
+  options = parser.parse_args(args)
+
+  server = HTTPServer(('localhost', options.port), CollectorHandler)
+  print('Listening on http://localhost:%d/' % options.port)
+  try:
+    server.serve_forever()
+  except KeyboardInterrupt:
+    STATS.report('partial rotation')
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
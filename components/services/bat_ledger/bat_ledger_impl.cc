@@ -591,6 +591,18 @@ void BatLedgerImpl::UpdateMediaDuration(
   ledger_->UpdateMediaDuration(window_id, publisher_key, duration, first_visit);
 }
 
+void BatLedgerImpl::UpdateMediaDurations(
+    const uint64_t window_id,
+    const std::string& publisher_key,
+    const std::vector<uint64_t>& durations,
+    const bool first_visit) {
+  ledger_->UpdateMediaDurations(
+      window_id,
+      publisher_key,
+      durations,
+      first_visit);
+}
+
 // static
 void BatLedgerImpl::OnPublisherInfo(
     CallbackHolder<GetPublisherInfoCallback>* holder,
@@ -1082,6 +1094,29 @@ void BatLedgerImpl::GetAllPromotions(GetAllPromotionsCallback callback) {
           _1));
 }
 
+// static
+void BatLedgerImpl::OnFlushPublisherActivity(
+    CallbackHolder<FlushPublisherActivityCallback>* holder,
+    const ledger::type::Result result) {
+  DCHECK(holder);
+  if (holder->is_valid()) {
+    std::move(holder->get()).Run(result);
+  }
+
+  delete holder;
+}
+
+void BatLedgerImpl::FlushPublisherActivity(
+    FlushPublisherActivityCallback callback) {
+  auto* holder = new CallbackHolder<FlushPublisherActivityCallback>(
+      AsWeakPtr(), std::move(callback));
+
+  ledger_->FlushPublisherActivity(
+      std::bind(BatLedgerImpl::OnFlushPublisherActivity,
+          holder,
+          _1));
+}
+
 // static
 void BatLedgerImpl::OnShutdown(
     CallbackHolder<ShutdownCallback>* holder,
@@ -160,6 +160,12 @@ class BatLedgerImpl :
       const uint64_t duration,
       const bool first_visit) override;
 
+  void UpdateMediaDurations(
+      const uint64_t window_id,
+      const std::string& publisher_key,
+      const std::vector<uint64_t>& durations,
+      const bool first_visit) override;
+
   void GetPublisherInfo(
       const std::string& publisher_key,
       GetPublisherInfoCallback callback) override;
@@ -239,6 +245,9 @@ class BatLedgerImpl :
 
   void GetAllPromotions(GetAllPromotionsCallback callback) override;
 
+  void FlushPublisherActivity(
+      FlushPublisherActivityCallback callback) override;
+
   void Shutdown(ShutdownCallback callback) override;
 
   void GetEventLogs(GetEventLogsCallback callback) override;
@@ -439,6 +448,10 @@ class BatLedgerImpl :
       CallbackHolder<GetAllPromotionsCallback>* holder,
       ledger::type::PromotionMap items);
 
+  static void OnFlushPublisherActivity(
+      CallbackHolder<FlushPublisherActivityCallback>* holder,
+      const ledger::type::Result result);
+
   static void OnShutdown(
       CallbackHolder<ShutdownCallback>* holder,
       const ledger::type::Result result);
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "net/http/http_response_headers.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr size_t kMaxEntries = 32;
+
+// Distilled pages are a few hundred kilobytes at most, anything bigger is
+// not worth keeping around.
+constexpr size_t kMaxBodySize = 4 * 1024 * 1024;
+
+std::string GetEntryKey(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
+}  // namespace
+
+SpeedreaderDistilledPageCache::SpeedreaderDistilledPageCache()
+    : entries_(kMaxEntries) {}
+
+SpeedreaderDistilledPageCache::~SpeedreaderDistilledPageCache() = default;
+
+// static
+std::string SpeedreaderDistilledPageCache::GetValidator(
+    const net::HttpResponseHeaders* headers) {
+  // Pages of logged in users are usually private, and responses varying
+  // with the request headers could differ for the next request. Setting a
+  // cookie hints that the page is personalized as well.
+  if (!headers || headers->response_code() != 200 ||
+      headers->HasHeaderValue("cache-control", "no-store") ||
+      headers->HasHeaderValue("cache-control", "private") ||
+      headers->HasHeader("vary") || headers->HasHeader("set-cookie")) {
+    return std::string();
+  }
+
+  std::string value;
+  if (headers->EnumerateHeader(nullptr, "etag", &value) && !value.empty())
+    return "etag:" + value;
+
+  if (headers->EnumerateHeader(nullptr, "last-modified", &value) &&
+      !value.empty()) {
+    return "last-modified:" + value;
+  }
+
+  return std::string();
+}
+
+base::Optional<std::string> SpeedreaderDistilledPageCache::Lookup(
+    const GURL& url,
+    const std::string& validator,
+    const std::string& rules_version) {
+  DCHECK(!validator.empty());
+  auto it = entries_.Get(GetEntryKey(url));
+  if (it != entries_.end()) {
+    const Entry& entry = it->second;
+    if (entry.validator == validator && entry.rules_version == rules_version) {
+      UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistilledPageCacheHit", true);
+      return entry.body;
+    }
+
+    // The page or the rules changed
+    entries_.Erase(it);
+  }
+
+  UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistilledPageCacheHit", false);
+  return base::nullopt;
+}
+
+void SpeedreaderDistilledPageCache::Store(const GURL& url,
+                                          const std::string& validator,
+                                          const std::string& rules_version,
+                                          const std::string& body) {
+  if (validator.empty() || body.size() > kMaxBodySize)
+    return;
+
+  entries_.Put(GetEntryKey(url), Entry{rules_version, validator, body});
+}
+
+void SpeedreaderDistilledPageCache::Clear() {
+  VLOG(2) << "Dropping distilled Speedreader pages";
+  entries_.Clear();
+}
+
+base::WeakPtr<SpeedreaderDistilledPageCache>
+SpeedreaderDistilledPageCache::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+}  // namespace speedreader
@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+
+namespace net {
+class HttpResponseHeaders;
+}
+
+class GURL;
+
+namespace speedreader {
+
+// Keeps the distilled output of recently loaded pages of a profile so that
+// reloads, back/forward navigations and repeat visits skip the rewriter.
+// Entries are keyed by URL and only served while the response validator (ETag
+// or Last-Modified) and the rules version (whitelist and stylesheet) still
+// match. Entries are only kept in memory, and are dropped along with the
+// cached browsing data of the profile.
+class SpeedreaderDistilledPageCache {
+ public:
+  struct Entry {
+    std::string rules_version;
+    std::string validator;
+    std::string body;
+  };
+
+  SpeedreaderDistilledPageCache();
+  ~SpeedreaderDistilledPageCache();
+
+  SpeedreaderDistilledPageCache(const SpeedreaderDistilledPageCache&) = delete;
+  SpeedreaderDistilledPageCache& operator=(
+      const SpeedreaderDistilledPageCache&) = delete;
+
+  // Returns the validator to key the response with, or an empty string if
+  // the response must not be cached. Responses which are private to the user
+  // or which vary with the request headers are never cached.
+  static std::string GetValidator(const net::HttpResponseHeaders* headers);
+
+  // Returns the cached body of |url| distilled with |rules_version|, or
+  // base::nullopt on a miss.
+  base::Optional<std::string> Lookup(const GURL& url,
+                                     const std::string& validator,
+                                     const std::string& rules_version);
+
+  // Stores the successfully distilled |body| of |url|.
+  void Store(const GURL& url,
+             const std::string& validator,
+             const std::string& rules_version,
+             const std::string& body);
+
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+  base::WeakPtr<SpeedreaderDistilledPageCache> GetWeakPtr();
+
+ private:
+  base::HashingMRUCache<std::string, Entry> entries_;
+  base::WeakPtrFactory<SpeedreaderDistilledPageCache> weak_factory_{this};
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
@@ -0,0 +1,99 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+
+#include <string>
+
+#include "net/http/http_response_headers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=SpeedreaderDistilledPageCacheTest.*
+
+namespace speedreader {
+
+class SpeedreaderDistilledPageCacheTest : public testing::Test {
+ protected:
+  SpeedreaderDistilledPageCache cache_;
+  const GURL url_ = GURL("https://example.com/article/1");
+};
+
+TEST_F(SpeedreaderDistilledPageCacheTest, GetValidator) {
+  auto headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nETag: \"abc\"\n"
+      "Last-Modified: Wed, 21 Oct 2015 07:28:00 GMT\n");
+  EXPECT_EQ("etag:\"abc\"",
+            SpeedreaderDistilledPageCache::GetValidator(headers.get()));
+
+  headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nLast-Modified: Wed, 21 Oct 2015 07:28:00 GMT\n");
+  EXPECT_EQ("last-modified:Wed, 21 Oct 2015 07:28:00 GMT",
+            SpeedreaderDistilledPageCache::GetValidator(headers.get()));
+
+  headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nETag: \"abc\"\nCache-Control: no-store\n");
+  EXPECT_TRUE(
+      SpeedreaderDistilledPageCache::GetValidator(headers.get()).empty());
+
+  headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nETag: \"abc\"\nCache-Control: max-age=0, private\n");
+  EXPECT_TRUE(
+      SpeedreaderDistilledPageCache::GetValidator(headers.get()).empty());
+
+  headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nETag: \"abc\"\nVary: Cookie\n");
+  EXPECT_TRUE(
+      SpeedreaderDistilledPageCache::GetValidator(headers.get()).empty());
+
+  headers = net::HttpResponseHeaders::TryToCreate(
+      "HTTP/1.1 200 OK\nETag: \"abc\"\nSet-Cookie: session=1\n");
+  EXPECT_TRUE(
+      SpeedreaderDistilledPageCache::GetValidator(headers.get()).empty());
+
+  headers = net::HttpResponseHeaders::TryToCreate("HTTP/1.1 200 OK\n");
+  EXPECT_TRUE(
+      SpeedreaderDistilledPageCache::GetValidator(headers.get()).empty());
+
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetValidator(nullptr).empty());
+}
+
+TEST_F(SpeedreaderDistilledPageCacheTest, ServesMatchingValidator) {
+  cache_.Store(url_, "etag:1", "1", "distilled");
+
+  EXPECT_EQ("distilled", cache_.Lookup(url_, "etag:1", "1"));
+  EXPECT_EQ("distilled",
+            cache_.Lookup(GURL(url_.spec() + "#comments"), "etag:1", "1"));
+  EXPECT_FALSE(cache_.Lookup(url_, "etag:2", "1"));
+  // The stale entry was dropped
+  EXPECT_FALSE(cache_.Lookup(url_, "etag:1", "1"));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(SpeedreaderDistilledPageCacheTest, RulesUpdateInvalidatesEntries) {
+  cache_.Store(url_, "etag:1", "1", "distilled");
+  EXPECT_FALSE(cache_.Lookup(url_, "etag:1", "2"));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(SpeedreaderDistilledPageCacheTest, Clear) {
+  cache_.Store(url_, "etag:1", "1", "distilled");
+  cache_.Clear();
+  EXPECT_EQ(0u, cache_.size());
+  EXPECT_FALSE(cache_.Lookup(url_, "etag:1", "1"));
+}
+
+TEST_F(SpeedreaderDistilledPageCacheTest, EvictsLeastRecentlyUsed) {
+  cache_.Store(url_, "etag:1", "1", "first");
+  for (int i = 0; i < 100; ++i) {
+    cache_.Store(GURL("https://example.com/" + std::to_string(i)), "etag:1",
+                 "1", "page");
+  }
+
+  EXPECT_GT(100u, cache_.size());
+  EXPECT_FALSE(cache_.Lookup(url_, "etag:1", "1"));
+}
+
+}  // namespace speedreader
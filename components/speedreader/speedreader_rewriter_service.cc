@@ -5,15 +5,18 @@
 
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 
+#include <memory>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/task/post_task.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_component.h"
 #include "components/grit/brave_components_resources.h"
+#include "crypto/sha2.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
 
@@ -46,6 +49,7 @@ SpeedreaderRewriterService::SpeedreaderRewriterService(
       ui::ResourceBundle::GetSharedInstance().LoadDataResourceString(
           IDR_SPEEDREADER_STYLE_DESKTOP) +
       "</style>";
+  UpdateRulesVersion();
 
   // Check the paths from the component as observer may register
   // later than the paths were available in the component.
@@ -72,7 +76,7 @@ void SpeedreaderRewriterService::OnWhitelistReady(const base::FilePath& path) {
           &brave_component_updater::LoadDATFileData<speedreader::SpeedReader>,
           path),
       base::BindOnce(&SpeedreaderRewriterService::OnLoadDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), path));
 }
 
 void SpeedreaderRewriterService::OnStylesheetReady(const base::FilePath& path) {
@@ -99,13 +103,26 @@ const std::string& SpeedreaderRewriterService::GetContentStylesheet() {
 void SpeedreaderRewriterService::OnLoadStylesheet(std::string stylesheet) {
   VLOG(2) << "Speedreader stylesheet loaded";
   content_stylesheet_ = stylesheet;
+  UpdateRulesVersion();
 }
 
 void SpeedreaderRewriterService::OnLoadDATFileData(
+    const base::FilePath& path,
     GetDATFileDataResult result) {
   VLOG(2) << "Speedreader loaded from DAT file";
-  if (result.first)
+  if (result.first) {
     speedreader_ = std::move(result.first);
+    whitelist_path_ = path;
+    UpdateRulesVersion();
+  }
+}
+
+void SpeedreaderRewriterService::UpdateRulesVersion() {
+  // Component updates are installed to versioned directories, so the path
+  // identifies the whitelist.
+  const std::string hash = crypto::SHA256HashString(
+      whitelist_path_.AsUTF8Unsafe() + '\n' + content_stylesheet_);
+  rules_version_ = base::HexEncode(hash.data(), hash.size() / 4);
 }
 
 }  // namespace speedreader
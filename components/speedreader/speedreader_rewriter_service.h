@@ -9,15 +9,12 @@
 #include <memory>
 #include <string>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/speedreader/speedreader_component.h"
 
-namespace base {
-class FilePath;
-}
-
 namespace speedreader {
 class SpeedReader;
 class Rewriter;
@@ -46,14 +43,22 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
   const std::string& GetContentStylesheet();
 
+  // Identifies the whitelist and the stylesheet, so that distilled pages
+  // are not served from the cache once either changes.
+  const std::string& rules_version() const { return rules_version_; }
+
  private:
   using GetDATFileDataResult =
       brave_component_updater::LoadDATFileDataResult<speedreader::SpeedReader>;
 
-  void OnLoadDATFileData(GetDATFileDataResult result);
+  void OnLoadDATFileData(const base::FilePath& path,
+                         GetDATFileDataResult result);
   void OnLoadStylesheet(std::string stylesheet);
+  void UpdateRulesVersion();
 
   std::string content_stylesheet_;
+  base::FilePath whitelist_path_;
+  std::string rules_version_;
   std::unique_ptr<speedreader::SpeedreaderComponent> component_;
   std::unique_ptr<speedreader::SpeedReader> speedreader_;
   base::WeakPtrFactory<SpeedreaderRewriterService> weak_factory_{this};
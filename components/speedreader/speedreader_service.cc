@@ -8,6 +8,7 @@
 #include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "brave/components/speedreader/features.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
 #include "brave/components/speedreader/speedreader_pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -74,7 +75,10 @@ void RecordHistograms(PrefService* prefs, bool toggled, bool enabled_now) {
 
 }  // namespace
 
-SpeedreaderService::SpeedreaderService(PrefService* prefs) : prefs_(prefs) {}
+SpeedreaderService::SpeedreaderService(PrefService* prefs)
+    : prefs_(prefs),
+      distilled_page_cache_(std::make_unique<SpeedreaderDistilledPageCache>()) {
+}
 
 SpeedreaderService::~SpeedreaderService() {}
 
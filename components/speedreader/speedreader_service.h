@@ -15,6 +15,8 @@ class PrefService;
 
 namespace speedreader {
 
+class SpeedreaderDistilledPageCache;
+
 class SpeedreaderService : public KeyedService {
  public:
   explicit SpeedreaderService(PrefService* prefs);
@@ -25,11 +27,17 @@ class SpeedreaderService : public KeyedService {
   void ToggleSpeedreader();
   bool IsEnabled();
 
+  // Distilled pages of this profile.
+  SpeedreaderDistilledPageCache* distilled_page_cache() {
+    return distilled_page_cache_.get();
+  }
+
   SpeedreaderService(const SpeedreaderService&) = delete;
   SpeedreaderService& operator=(const SpeedreaderService&) = delete;
 
  private:
   PrefService* prefs_ = nullptr;
+  std::unique_ptr<SpeedreaderDistilledPageCache> distilled_page_cache_;
 };
 
 }  // namespace speedreader
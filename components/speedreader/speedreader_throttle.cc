@@ -5,24 +5,35 @@
 
 #include "brave/components/speedreader/speedreader_throttle.h"
 
+#include <string>
 #include <utility>
 
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_url_loader.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/http/http_request_headers.h"
+#include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
 namespace speedreader {
 
 SpeedReaderThrottle::SpeedReaderThrottle(
     SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner)
     : rewriter_service_(rewriter_service),
+      distilled_page_cache_(std::move(distilled_page_cache)),
       task_runner_(std::move(task_runner)) {}
 
 SpeedReaderThrottle::~SpeedReaderThrottle() = default;
 
+void SpeedReaderThrottle::WillStartRequest(network::ResourceRequest* request,
+                                           bool* defer) {
+  is_get_request_ = request->method == net::HttpRequestHeaders::kGetMethod;
+}
+
 void SpeedReaderThrottle::WillProcessResponse(
     const GURL& response_url,
     network::mojom::URLResponseHead* response_head,
@@ -36,10 +47,15 @@ void SpeedReaderThrottle::WillProcessResponse(
   mojo::PendingRemote<network::mojom::URLLoader> source_loader;
   mojo::PendingReceiver<network::mojom::URLLoaderClient> source_client_receiver;
   SpeedReaderURLLoader* speedreader_loader;
+  const std::string cache_validator =
+      distilled_page_cache_ && is_get_request_
+          ? SpeedreaderDistilledPageCache::GetValidator(
+                response_head->headers.get())
+          : std::string();
   std::tie(new_remote, new_receiver, speedreader_loader) =
-      SpeedReaderURLLoader::CreateLoader(weak_factory_.GetWeakPtr(),
-                                         response_url, task_runner_,
-                                         rewriter_service_);
+      SpeedReaderURLLoader::CreateLoader(
+          weak_factory_.GetWeakPtr(), response_url, task_runner_,
+          rewriter_service_, distilled_page_cache_, cache_validator);
   delegate_->InterceptResponse(std::move(new_remote), std::move(new_receiver),
                                &source_loader, &source_client_receiver);
   speedreader_loader->Start(std::move(source_loader),
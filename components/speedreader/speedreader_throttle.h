@@ -12,6 +12,7 @@
 
 namespace speedreader {
 
+class SpeedreaderDistilledPageCache;
 class SpeedreaderRewriterService;
 
 // Launches the speedreader distillation pass over a reponce body, deferring
@@ -24,15 +25,21 @@ class SpeedReaderThrottle : public blink::URLLoaderThrottle {
  public:
   // |task_runner| is used to bind the right task runner for handling incoming
   // IPC in SpeedReaderLoader. |task_runner| is supposed to be bound to the
-  // current sequence.
-  SpeedReaderThrottle(SpeedreaderRewriterService* rewriter_service,
-                      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+  // current sequence. |distilled_page_cache| is the cache of the profile
+  // loading the page. It may be null, e.g. for off-the-record profiles, in
+  // which case pages are always distilled.
+  SpeedReaderThrottle(
+      SpeedreaderRewriterService* rewriter_service,
+      base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache,
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
   ~SpeedReaderThrottle() override;
 
   SpeedReaderThrottle(const SpeedReaderThrottle&) = delete;
   SpeedReaderThrottle& operator=(const SpeedReaderThrottle&) = delete;
 
   // Implements blink::URLLoaderThrottle.
+  void WillStartRequest(network::ResourceRequest* request,
+                        bool* defer) override;
   void WillProcessResponse(const GURL& response_url,
                            network::mojom::URLResponseHead* response_head,
                            bool* defer) override;
@@ -42,6 +49,9 @@ class SpeedReaderThrottle : public blink::URLLoaderThrottle {
 
  private:
   SpeedreaderRewriterService* rewriter_service_;  // not owned
+  base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache_;
+  // Only responses to GET requests are cached.
+  bool is_get_request_ = false;
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   base::WeakPtrFactory<SpeedReaderThrottle> weak_factory_{this};
 };
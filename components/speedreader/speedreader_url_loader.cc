@@ -13,6 +13,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
@@ -34,7 +35,9 @@ SpeedReaderURLLoader::CreateLoader(
     base::WeakPtr<SpeedReaderThrottle> throttle,
     const GURL& response_url,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-    SpeedreaderRewriterService* rewriter_service) {
+    SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache,
+    const std::string& cache_validator) {
   mojo::PendingRemote<network::mojom::URLLoader> url_loader;
   mojo::PendingRemote<network::mojom::URLLoaderClient> url_loader_client;
   mojo::PendingReceiver<network::mojom::URLLoaderClient>
@@ -43,7 +46,8 @@ SpeedReaderURLLoader::CreateLoader(
 
   auto loader = base::WrapUnique(new SpeedReaderURLLoader(
       std::move(throttle), response_url, std::move(url_loader_client),
-      std::move(task_runner), rewriter_service));
+      std::move(task_runner), rewriter_service, std::move(distilled_page_cache),
+      cache_validator));
   SpeedReaderURLLoader* loader_rawptr = loader.get();
   mojo::MakeSelfOwnedReceiver(std::move(loader),
                               url_loader.InitWithNewPipeAndPassReceiver());
@@ -57,7 +61,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
     mojo::PendingRemote<network::mojom::URLLoaderClient>
         destination_url_loader_client,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-    SpeedreaderRewriterService* rewriter_service)
+    SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache,
+    const std::string& cache_validator)
     : throttle_(throttle),
       destination_url_loader_client_(std::move(destination_url_loader_client)),
       response_url_(response_url),
@@ -68,7 +74,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
-      rewriter_service_(rewriter_service) {}
+      rewriter_service_(rewriter_service),
+      distilled_page_cache_(std::move(distilled_page_cache)),
+      cache_validator_(cache_validator) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
 
@@ -241,41 +249,67 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
   if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
-    base::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
-                       weak_factory_.GetWeakPtr()));
+    if (distilled_page_cache_ && !cache_validator_.empty()) {
+      base::Optional<std::string> body = distilled_page_cache_->Lookup(
+          response_url_, cache_validator_, rewriter_service_->rules_version());
+      if (body) {
+        VLOG(2) << __func__ << " serving cached page " << response_url_;
+        CompleteLoading(std::move(*body));
+        return;
+      }
+    }
+    Distill();
     return;
   }
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::Distill() {
+  // Offload heavy distilling to another thread. The result tells whether the
+  // page was distilled, or the untouched body is returned.
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(
+          [](std::string data, std::unique_ptr<Rewriter> rewriter,
+             const std::string& stylesheet) -> std::pair<bool, std::string> {
+            SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
+            int written = rewriter->Write(data.c_str(), data.length());
+            // Error occurred
+            if (written != 0) {
+              return {false, std::move(data)};
+            }
+
+            rewriter->End();
+            const std::string& transformed = rewriter->GetOutput();
+
+            // TODO(brave-browser/issues/10372): would be better to pass
+            // explicit signal back from rewriter to indicate if content was
+            // found
+            if (transformed.length() < 1024) {
+              return {false, std::move(data)};
+            }
+
+            return {true, stylesheet + transformed};
+          },
+          std::move(buffered_body_),
+          rewriter_service_->MakeRewriter(response_url_),
+          rewriter_service_->GetContentStylesheet()),
+      base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
+                     weak_factory_.GetWeakPtr(),
+                     rewriter_service_->rules_version()));
+}
+
+void SpeedReaderURLLoader::OnDistilled(const std::string& rules_version,
+                                       std::pair<bool, std::string> result) {
+  // Pages which could not be distilled are loaded as usual next time, there
+  // is no point in keeping them.
+  if (result.first && distilled_page_cache_ && !cache_validator_.empty()) {
+    distilled_page_cache_->Store(response_url_, cache_validator_,
+                                 rules_version, result.second);
+  }
+  CompleteLoading(std::move(result.second));
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
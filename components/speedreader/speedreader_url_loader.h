@@ -8,11 +8,13 @@
 
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -27,6 +29,7 @@
 namespace speedreader {
 
 class SpeedReaderThrottle;
+class SpeedreaderDistilledPageCache;
 class SpeedreaderRewriterService;
 
 // Loads the whole response body and tries to Speedreader-distill it.
@@ -72,7 +75,10 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   CreateLoader(base::WeakPtr<SpeedReaderThrottle> throttle,
                const GURL& response_url,
                scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-               SpeedreaderRewriterService* rewriter_service);
+               SpeedreaderRewriterService* rewriter_service,
+               base::WeakPtr<SpeedreaderDistilledPageCache>
+                   distilled_page_cache,
+               const std::string& cache_validator);
 
  private:
   SpeedReaderURLLoader(base::WeakPtr<SpeedReaderThrottle> throttle,
@@ -80,7 +86,10 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                        mojo::PendingRemote<network::mojom::URLLoaderClient>
                            destination_url_loader_client,
                        scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-                       SpeedreaderRewriterService* rewriter_service);
+                       SpeedreaderRewriterService* rewriter_service,
+                       base::WeakPtr<SpeedreaderDistilledPageCache>
+                           distilled_page_cache,
+                       const std::string& cache_validator);
 
   // network::mojom::URLLoaderClient implementation (called from the source of
   // the response):
@@ -113,6 +122,9 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  void Distill();
+  void OnDistilled(const std::string& rules_version,
+                   std::pair<bool, std::string> result);
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
@@ -149,6 +161,10 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   // Not Owned
   SpeedreaderRewriterService* rewriter_service_;
+  base::WeakPtr<SpeedreaderDistilledPageCache> distilled_page_cache_;
+
+  // ETag or Last-Modified of the response, empty if it must not be cached.
+  const std::string cache_validator_;
 
   base::WeakPtrFactory<SpeedReaderURLLoader> weak_factory_{this};
 };
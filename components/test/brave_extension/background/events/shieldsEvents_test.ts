@@ -24,4 +24,22 @@ describe('shieldsEvents events', () => {
       chrome.braveShields.onBlocked.emit(blockedResource)
     })
   })
+  describe('chrome.braveShields.onBlockedResources listener', () => {
+    let spy: jest.SpyInstance
+    beforeEach(() => {
+      spy = jest.spyOn(actions, 'resourceBlocked')
+    })
+    afterEach(() => {
+      spy.mockRestore()
+    })
+    it('forwards each detail to actions.resourceBlocked', (cb) => {
+      chrome.braveShields.onBlockedResources.addListener((details) => {
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toBeCalledWith(details[0])
+        expect(spy).toBeCalledWith(details[1])
+        cb()
+      })
+      chrome.braveShields.onBlockedResources.emit([blockedResource, blockedResource])
+    })
+  })
 })
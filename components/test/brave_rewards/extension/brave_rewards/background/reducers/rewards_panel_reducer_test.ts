@@ -361,7 +361,7 @@ describe('rewards panel reducer', () => {
           key_2: {
             tabUrl: 'https://brave4.com',
             publisherKey: 'brave4.com',
-            percentage: 0,
+            percentage: 40,
             status: 2
           }
         }
@@ -6,6 +6,20 @@
 import reducers from '../../../../brave_rewards/resources/page/reducers/index'
 import { types } from '../../../../brave_rewards/resources/page/constants/rewards_types'
 import { defaultState } from '../../../../brave_rewards/resources/page/storage'
+import { getMockChrome } from '../../../testData'
+
+const createPublisher = (publisherKey: string, percentage: number): Rewards.Publisher => ({
+  publisherKey,
+  percentage,
+  status: 0,
+  excluded: 0,
+  url: `https://${publisherKey}`,
+  name: publisherKey,
+  provider: '',
+  favIcon: '',
+  id: publisherKey,
+  weight: percentage
+})
 
 describe('publishers reducer', () => {
   describe('ON_EXCLUDED_LIST', () => {
@@ -78,4 +92,121 @@ describe('publishers reducer', () => {
       })
     })
   })
+
+  describe('ON_CONTRIBUTE_LIST_PAGE', () => {
+    let chromeSpy: jest.SpyInstance
+
+    (global as any).chrome = getMockChrome()
+
+    beforeEach(() => {
+      chromeSpy = jest.spyOn(chrome, 'send')
+    })
+
+    afterEach(() => {
+      chromeSpy.mockRestore()
+    })
+
+    it('first page replaces the list and asks for the next one', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [createPublisher('old.com', 100)]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_PAGE,
+        payload: {
+          page: {
+            cursor: 0,
+            nextCursor: 2,
+            publishers: [
+              createPublisher('brave.com', 60),
+              createPublisher('foo.com', 40)
+            ]
+          }
+        }
+      })
+
+      expect(assertion.rewardsData.autoContributeList).toEqual([
+        createPublisher('brave.com', 60),
+        createPublisher('foo.com', 40)
+      ])
+      expect(chromeSpy).toHaveBeenCalledWith(
+        'brave_rewards.getContributionListPage', [2])
+    })
+
+    it('appends the last page', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [
+        createPublisher('brave.com', 60),
+        createPublisher('foo.com', 30)
+      ]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_PAGE,
+        payload: {
+          page: {
+            cursor: 2,
+            publishers: [
+              createPublisher('foo.com', 30),
+              createPublisher('bar.com', 10)
+            ]
+          }
+        }
+      })
+
+      expect(assertion.rewardsData.autoContributeList).toEqual([
+        createPublisher('brave.com', 60),
+        createPublisher('foo.com', 30),
+        createPublisher('bar.com', 10)
+      ])
+      expect(chromeSpy).toHaveBeenCalledTimes(0)
+    })
+  })
+
+  describe('ON_CONTRIBUTE_LIST_CHANGED', () => {
+    it('merges changed publishers', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [
+        createPublisher('brave.com', 60),
+        createPublisher('foo.com', 30),
+        createPublisher('bar.com', 10)
+      ]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_CHANGED,
+        payload: {
+          list: [
+            createPublisher('brave.com', 40),
+            createPublisher('foo.com', 0),
+            createPublisher('new.com', 50)
+          ]
+        }
+      })
+
+      expect(assertion.rewardsData.autoContributeList).toEqual([
+        createPublisher('new.com', 50),
+        createPublisher('brave.com', 40),
+        createPublisher('bar.com', 10)
+      ])
+    })
+
+    it('merges into a list of 10k publishers', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = []
+      for (let i = 0; i < 10000; i++) {
+        initialState.autoContributeList.push(
+          createPublisher(`publisher${10000 + i}.com`, 1))
+      }
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_CHANGED,
+        payload: {
+          list: [createPublisher('publisher19999.com', 5)]
+        }
+      })
+
+      const list = assertion.rewardsData.autoContributeList
+      expect(list.length).toBe(10000)
+      expect(list[0]).toEqual(createPublisher('publisher19999.com', 5))
+      expect(list[1].publisherKey).toBe('publisher10000.com')
+    })
+  })
 })
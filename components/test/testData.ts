@@ -213,6 +213,7 @@ export const getMockChrome = () => {
     },
     braveShields: {
       onBlocked: new ChromeEvent(),
+      onBlockedResources: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -301,6 +302,7 @@ export const getMockChrome = () => {
         return Promise.resolve()
       },
       onBlocked: new ChromeEvent(),
+      onBlockedResources: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -8,20 +8,23 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "crypto/random.h"
-#include "net/base/network_isolation_key.h"
-#include "net/base/schemeful_site.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/proxy_resolution/proxy_config_with_annotation.h"
 #include "net/proxy_resolution/proxy_resolution_service.h"
+#include "url/gurl.h"
+#include "url/origin.h"
 
 namespace net {
 
@@ -35,14 +38,27 @@ class TorProxyMap {
   void MaybeExpire(const std::string& key, const base::Time& timestamp);
   size_t size() const;
 
+  // Returns ProxyConfigServiceTor::CircuitIsolationKey(url), cached by host
+  // for the web schemes which make up nearly all proxied requests.
+  const std::string& GetCircuitIsolationKey(const GURL& url);
+  size_t cached_isolation_key_count() const;
+
  private:
+  using TimestampedUsername = std::pair<base::Time, std::string>;
+
   // Generate a new base 64-encoded 128 bit random tag
   static std::string GenerateNewPassword();
   // Clear expired entries in the queue from the map.
   void ClearExpiredEntries();
   std::map<std::string, std::pair<std::string, base::Time>> map_;
-  std::priority_queue<std::pair<base::Time, std::string>> queue_;
+  // Oldest entry on top
+  std::priority_queue<TimestampedUsername,
+                      std::vector<TimestampedUsername>,
+                      std::greater<TimestampedUsername>>
+      queue_;
   base::OneShotTimer timer_;
+  base::HashingMRUCache<std::string, std::string> isolation_keys_;
+  std::string isolation_key_;
   DISALLOW_COPY_AND_ASSIGN(TorProxyMap);
 };
 
@@ -98,6 +114,9 @@ bool IsTorProxyConfig(const ProxyConfigWithAnnotation& config) {
 }  // namespace
 
 const int kTorPasswordLength = 16;
+// Number of hosts whose circuit isolation key is cached per proxy
+// resolution service
+constexpr size_t kMaxCachedIsolationKeys = 256;
 // Default tor circuit life time is 10 minutes
 constexpr base::TimeDelta kTenMins = base::TimeDelta::FromMinutes(10);
 
@@ -137,14 +156,19 @@ std::string ProxyConfigServiceTor::CircuitIsolationKey(const GURL& url) {
   //
   // In particular, we need not isolate by the scheme,
   // username/password, port, path, or query part of the URL.
-  const net::SchemefulSite url_site(url);
-  const net::NetworkIsolationKey network_isolation_key(url_site, url_site);
-
-  const base::Optional<net::SchemefulSite>& schemeful_site =
-      network_isolation_key.GetTopFrameSite();
-  DCHECK(schemeful_site.has_value());
-  std::string host = GURL(schemeful_site->Serialize()).host();
-  return host;
+  //
+  // This is the host of the schemeful site of |url|, computed directly
+  // rather than through a round trip via its serialization.
+  const url::Origin origin = url::Origin::Create(url);
+  if (origin.opaque())
+    return std::string();
+
+  std::string domain = registry_controlled_domains::GetDomainAndRegistry(
+      origin, registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  if (domain.empty())
+    return origin.host();
+
+  return domain;
 }
 
 void ProxyConfigServiceTor::SetNewTorCircuit(const GURL& url) {
@@ -176,14 +200,12 @@ void ProxyConfigServiceTor::SetProxyAuthorization(
 
   // Adding username & password to global sock://127.0.0.1:[port] config
   // without actually modifying it when resolving proxy for each url.
-  const std::string username = CircuitIsolationKey(url);
-  const std::string& proxy_uri =
-      config.value().proxy_rules().single_proxies.Get().ToURI();
+  auto* map = GetTorProxyMap(service);
+  const std::string& username = map->GetCircuitIsolationKey(url);
   HostPortPair host_port_pair =
       config.value().proxy_rules().single_proxies.Get().host_port_pair();
 
   if (!username.empty()) {
-    auto* map = GetTorProxyMap(service);
     if (host_port_pair.username() == username) {
       // password is a int64_t -> std::to_string in milliseconds
       int64_t time = strtoll(host_port_pair.password().c_str(), nullptr, 10);
@@ -194,18 +216,24 @@ void ProxyConfigServiceTor::SetProxyAuthorization(
     host_port_pair.set_username(username);
     host_port_pair.set_password(map->Get(username));
 
-    ProxyConfigServiceTor tor_proxy_config_service(proxy_uri);
-    tor_proxy_config_service.proxy_server_ =
-        ProxyServer(ProxyServer::SCHEME_SOCKS5, host_port_pair);
-
-    ProxyConfigWithAnnotation fetched_config;
-    tor_proxy_config_service.GetLatestProxyConfig(&fetched_config);
-    fetched_config.value().proxy_rules().Apply(url, result);
-    result->set_traffic_annotation(MutableNetworkTrafficAnnotationTag(
-        fetched_config.traffic_annotation()));
+    // The rules of |config| only differ from the ones we want in the
+    // credentials of the single proxy, so swap those in instead of
+    // building and parsing a new config.
+    ProxyConfig::ProxyRules proxy_rules = config.value().proxy_rules();
+    proxy_rules.single_proxies.SetSingleProxyServer(
+        ProxyServer(ProxyServer::SCHEME_SOCKS5, host_port_pair));
+    proxy_rules.Apply(url, result);
+    result->set_traffic_annotation(
+        MutableNetworkTrafficAnnotationTag(config.traffic_annotation()));
   }
 }
 
+// static
+size_t ProxyConfigServiceTor::GetCachedIsolationKeyCountForTesting(
+    ProxyResolutionService* service) {
+  return GetTorProxyMap(service)->cached_isolation_key_count();
+}
+
 void ProxyConfigServiceTor::AddObserver(Observer* observer) {
   observers_.AddObserver(observer);
 }
@@ -229,7 +257,7 @@ ProxyConfigServiceTor::GetLatestProxyConfig(
   return CONFIG_VALID;
 }
 
-TorProxyMap::TorProxyMap() = default;
+TorProxyMap::TorProxyMap() : isolation_keys_(kMaxCachedIsolationKeys) {}
 TorProxyMap::~TorProxyMap() {
   timer_.Stop();
 }
@@ -272,6 +300,25 @@ size_t TorProxyMap::size() const {
   return map_.size();
 }
 
+const std::string& TorProxyMap::GetCircuitIsolationKey(const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS() && !url.SchemeIsWSOrWSS()) {
+    isolation_key_ = ProxyConfigServiceTor::CircuitIsolationKey(url);
+    return isolation_key_;
+  }
+
+  auto found = isolation_keys_.Get(url.host());
+  if (found == isolation_keys_.end()) {
+    found = isolation_keys_.Put(
+        url.host(), ProxyConfigServiceTor::CircuitIsolationKey(url));
+  }
+
+  return found->second;
+}
+
+size_t TorProxyMap::cached_isolation_key_count() const {
+  return isolation_keys_.size();
+}
+
 void TorProxyMap::Erase(const std::string& username) {
   // Just erase it from the map.  There will remain an entry in the
   // queue, but it is harmless.  If anyone creates a new entry in the
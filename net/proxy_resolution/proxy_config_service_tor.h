@@ -6,6 +6,8 @@
 #ifndef BRAVE_NET_PROXY_RESOLUTION_PROXY_CONFIG_SERVICE_TOR_H_
 #define BRAVE_NET_PROXY_RESOLUTION_PROXY_CONFIG_SERVICE_TOR_H_
 
+#include <stddef.h>
+
 #include <map>
 #include <queue>
 #include <string>
@@ -47,6 +49,10 @@ class NET_EXPORT ProxyConfigServiceTor : public net::ProxyConfigService {
                                     ProxyResolutionService* service,
                                     ProxyInfo* result);
 
+  // Number of hosts whose circuit isolation key is cached for |service|.
+  static size_t GetCachedIsolationKeyCountForTesting(
+      ProxyResolutionService* service);
+
   // ProxyConfigService methods:
   void AddObserver(Observer* observer) override;
   void RemoveObserver(Observer* observer) override;
@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "brave/net/proxy_resolution/proxy_config_service_tor.h"
+#include "net/proxy_resolution/configured_proxy_resolution_service.h"
+#include "net/proxy_resolution/mock_proxy_resolver.h"
+#include "net/proxy_resolution/proxy_config_with_annotation.h"
+#include "net/test/test_with_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_perftests --filter=ProxyConfigServiceTorPerfTest.*
+
+namespace net {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "ProxyConfigServiceTor.";
+constexpr char kMetricResolution[] = "resolution";
+constexpr char kMetricThroughput[] = "throughput";
+
+constexpr int kRequests = 100000;
+
+}  // namespace
+
+class ProxyConfigServiceTorPerfTest : public TestWithTaskEnvironment {
+ protected:
+  // Authorizes |kRequests| requests cycling through |urls| and reports the
+  // time spent per request.
+  void RunBenchmark(const std::string& story, const std::vector<GURL>& urls) {
+    auto config_service =
+        ConfiguredProxyResolutionService::CreateSystemProxyConfigService(
+            base::ThreadTaskRunnerHandle::Get());
+    auto service = std::make_unique<ConfiguredProxyResolutionService>(
+        std::move(config_service),
+        std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+        /*quick_check_enabled=*/true);
+
+    ProxyConfigServiceTor proxy_config_service("socks5://127.0.0.1:5566");
+    ProxyConfigWithAnnotation config;
+    proxy_config_service.GetLatestProxyConfig(&config);
+
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kRequests; i++) {
+      ProxyInfo info;
+      ProxyConfigServiceTor::SetProxyAuthorization(
+          config, urls[i % urls.size()], service.get(), &info);
+      ASSERT_FALSE(info.proxy_server().host_port_pair().username().empty());
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricResolution, "us");
+    reporter.RegisterImportantMetric(kMetricThroughput, "runs/s");
+    reporter.AddResult(kMetricResolution, elapsed / kRequests);
+    reporter.AddResult(kMetricThroughput, kRequests / elapsed.InSecondsF());
+  }
+};
+
+// A few sites, as in a tab loading its subresources; every isolation key
+// lookup hits the cache.
+TEST_F(ProxyConfigServiceTorPerfTest, FewHosts) {
+  RunBenchmark("few_hosts", {GURL("https://check.torproject.org/"),
+                             GURL("https://www.torproject.org/download/"),
+                             GURL("https://brave.com/"),
+                             GURL("https://cdn.brave.com/image.png")});
+}
+
+// More hosts than the isolation key cache holds, cycled in order, so every
+// lookup misses it.
+TEST_F(ProxyConfigServiceTorPerfTest, ManyHosts) {
+  std::vector<GURL> urls;
+  for (int i = 0; i < 1000; i++)
+    urls.emplace_back(base::StringPrintf("https://www.site%d.co.uk/", i));
+  RunBenchmark("many_hosts", urls);
+}
+
+}  // namespace net
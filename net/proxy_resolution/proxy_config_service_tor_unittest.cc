@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/strings/stringprintf.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "net/base/proxy_server.h"
 #include "net/proxy_resolution/configured_proxy_resolution_service.h"
@@ -29,6 +30,17 @@ class ProxyConfigServiceTorTest : public TestWithTaskEnvironment {
   DISALLOW_COPY_AND_ASSIGN(ProxyConfigServiceTorTest);
 };
 
+class ProxyConfigServiceTorMockTimeTest : public TestWithTaskEnvironment {
+ public:
+  ProxyConfigServiceTorMockTimeTest()
+      : TestWithTaskEnvironment(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+  ~ProxyConfigServiceTorMockTimeTest() override {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ProxyConfigServiceTorMockTimeTest);
+};
+
 TEST_F(ProxyConfigServiceTorTest, CircuitIsolationKey) {
   const struct {
     GURL url;
@@ -94,6 +106,18 @@ TEST_F(ProxyConfigServiceTorTest, CircuitIsolationKey) {
           GURL("https://www.bbc.co.uk/"),
           "bbc.co.uk",
       },
+      {
+          GURL("wss://www.bbc.co.uk/"),
+          "bbc.co.uk",
+      },
+      {
+          GURL("blob:https://www.bbc.co.uk/0c1b8c2c-4f1c-4b1b-9d1c"),
+          "bbc.co.uk",
+      },
+      {
+          GURL("data:text/plain,tor"),
+          "",
+      },
   };
 
   for (auto& c : cases) {
@@ -211,4 +235,110 @@ TEST_F(ProxyConfigServiceTorTest, SetProxyAuthorization) {
   EXPECT_EQ(host_port_pair.port(), 5566);
 }
 
+TEST_F(ProxyConfigServiceTorTest, CachesCircuitIsolationKeysByHost) {
+  const std::string proxy_uri("socks5://127.0.0.1:5566");
+  // Matches kMaxCachedIsolationKeys
+  const size_t kMaxCachedIsolationKeys = 256;
+
+  auto config_service =
+      ConfiguredProxyResolutionService::CreateSystemProxyConfigService(
+          base::ThreadTaskRunnerHandle::Get());
+  auto service = std::make_unique<ConfiguredProxyResolutionService>(
+      std::move(config_service),
+      std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+      /*quick_check_enabled=*/true);
+
+  ProxyConfigServiceTor proxy_config_service(proxy_uri);
+  ProxyConfigWithAnnotation config;
+  proxy_config_service.GetLatestProxyConfig(&config);
+
+  auto resolve = [&](const std::string& url) {
+    ProxyInfo info;
+    ProxyConfigServiceTor::SetProxyAuthorization(config, GURL(url),
+                                                 service.get(), &info);
+    return info.proxy_server().host_port_pair();
+  };
+  auto cached_keys = [&]() {
+    return ProxyConfigServiceTor::GetCachedIsolationKeyCountForTesting(
+        service.get());
+  };
+
+  // The first request for a host misses the cache.
+  const HostPortPair first = resolve("https://check.torproject.org/");
+  EXPECT_EQ("torproject.org", first.username());
+  EXPECT_EQ(1u, cached_keys());
+
+  // Other paths and web schemes on the same host hit it.
+  HostPortPair host_port_pair = resolve("https://check.torproject.org/x?y");
+  EXPECT_EQ(first.username(), host_port_pair.username());
+  EXPECT_EQ(first.password(), host_port_pair.password());
+  host_port_pair = resolve("wss://check.torproject.org:8443/");
+  EXPECT_EQ(first.username(), host_port_pair.username());
+  EXPECT_EQ(first.password(), host_port_pair.password());
+  EXPECT_EQ(1u, cached_keys());
+
+  // The cache is keyed by host, but hosts of the same site share a circuit.
+  host_port_pair = resolve("https://www.torproject.org/download/");
+  EXPECT_EQ(first.username(), host_port_pair.username());
+  EXPECT_EQ(first.password(), host_port_pair.password());
+  EXPECT_EQ(2u, cached_keys());
+
+  // Other schemes are resolved without the cache.
+  host_port_pair =
+      resolve("blob:https://www.bbc.co.uk/0c1b8c2c-4f1c-4b1b-9d1c");
+  EXPECT_EQ("bbc.co.uk", host_port_pair.username());
+  EXPECT_EQ(2u, cached_keys());
+
+  // The cache is bounded, and evicting a host keeps its circuit.
+  for (size_t i = 0; i < kMaxCachedIsolationKeys; i++) {
+    host_port_pair = resolve(base::StringPrintf("https://site%zu.com/", i));
+    EXPECT_EQ(base::StringPrintf("site%zu.com", i), host_port_pair.username());
+  }
+  EXPECT_EQ(kMaxCachedIsolationKeys, cached_keys());
+  host_port_pair = resolve("https://check.torproject.org/");
+  EXPECT_EQ(first.username(), host_port_pair.username());
+  EXPECT_EQ(first.password(), host_port_pair.password());
+  EXPECT_EQ(kMaxCachedIsolationKeys, cached_keys());
+}
+
+TEST_F(ProxyConfigServiceTorMockTimeTest, CircuitsExpireOldestFirst) {
+  const std::string proxy_uri("socks5://127.0.0.1:5566");
+  const GURL site_url("https://check.torproject.org/");
+  const GURL site_url2("https://brave.com/");
+
+  auto config_service =
+      ConfiguredProxyResolutionService::CreateSystemProxyConfigService(
+          base::ThreadTaskRunnerHandle::Get());
+  auto service = std::make_unique<ConfiguredProxyResolutionService>(
+      std::move(config_service),
+      std::make_unique<MockAsyncProxyResolverFactory>(false), nullptr,
+      /*quick_check_enabled=*/true);
+
+  ProxyConfigServiceTor proxy_config_service(proxy_uri);
+  ProxyConfigWithAnnotation config;
+  proxy_config_service.GetLatestProxyConfig(&config);
+
+  auto get_password = [&](const GURL& url) {
+    ProxyInfo info;
+    ProxyConfigServiceTor::SetProxyAuthorization(config, url, service.get(),
+                                                 &info);
+    return info.proxy_server().host_port_pair().password();
+  };
+
+  const std::string password = get_password(site_url);
+  FastForwardBy(base::TimeDelta::FromMinutes(5));
+  const std::string password2 = get_password(site_url2);
+
+  // The first circuit is now older than ten minutes while the second one is
+  // not, and the expiry timer was pushed back by the second circuit. Only the
+  // first circuit must be replaced.
+  FastForwardBy(base::TimeDelta::FromMinutes(6));
+  EXPECT_NE(password, get_password(site_url));
+  EXPECT_EQ(password2, get_password(site_url2));
+
+  // Once the second circuit is ten minutes old too, it is replaced as well.
+  FastForwardBy(base::TimeDelta::FromMinutes(5));
+  EXPECT_NE(password2, get_password(site_url2));
+}
+
 }  // namespace net
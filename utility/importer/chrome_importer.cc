@@ -234,13 +234,16 @@ void ChromeImporter::ImportHistory() {
     return;
   }
 
+  // Chrome keeps a row per visit, aggregate them so that each URL is imported
+  // once with its most recent visit.
   const char query[] =
-    "SELECT u.url, u.title, v.visit_time, u.typed_count, u.visit_count "
+    "SELECT u.url, u.title, MAX(v.visit_time), u.typed_count, u.visit_count "
     "FROM urls u JOIN visits v ON u.id = v.url "
     "WHERE hidden = 0 "
     "AND (transition & ?) != 0 "  // CHAIN_END
-    "AND (transition & ?) NOT IN (?, ?, ?)";  // No SUBFRAME or
+    "AND (transition & ?) NOT IN (?, ?, ?) "  // No SUBFRAME or
                                               // KEYWORD_GENERATED
+    "GROUP BY u.id";
 
   sql::Statement s(db.GetUniqueStatement(query));
   s.BindInt64(0, ui::PAGE_TRANSITION_CHAIN_END);
@@ -249,7 +252,10 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(3, ui::PAGE_TRANSITION_MANUAL_SUBFRAME);
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
+  // Rows are sent in batches so that neither process holds the whole history
+  // of large profiles at once.
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kHistoryBatchSize);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -262,6 +268,11 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+
+    if (rows.size() == kHistoryBatchSize) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
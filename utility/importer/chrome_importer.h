@@ -6,6 +6,7 @@
 #ifndef BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_H_
 #define BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -32,6 +33,9 @@ class Database;
 
 class ChromeImporter : public Importer {
  public:
+  // The maximum number of history rows passed to the bridge at once.
+  static constexpr size_t kHistoryBatchSize = 1000;
+
   ChromeImporter();
 
   // Importer:
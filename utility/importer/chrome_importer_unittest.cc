@@ -6,11 +6,13 @@
 #include "brave/utility/importer/chrome_importer.h"
 
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/brave_paths.h"
 #include "chrome/common/chrome_paths.h"
@@ -20,7 +22,11 @@
 #include "chrome/common/importer/mock_importer_bridge.h"
 #include "components/favicon_base/favicon_usage_data.h"
 #include "components/os_crypt/os_crypt_mocker.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/page_transition_types.h"
 
 using base::ASCIIToUTF16;
 using base::UTF16ToASCII;
@@ -87,6 +93,85 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportHistoryInBatches) {
+  // Replace the test profile's history with one which has several visits for
+  // each URL and more URLs than fit in one batch.
+  const size_t kURLCount = ChromeImporter::kHistoryBatchSize * 2 + 500;
+  const int kVisitsPerURL = 3;
+  // Microseconds since the Windows epoch, as stored by Chrome.
+  const int64_t kFirstVisitTime = 13165369272568785;
+  {
+    base::FilePath history_path = profile_dir_.AppendASCII("History");
+    ASSERT_TRUE(base::DeleteFile(history_path));
+    sql::Database db;
+    ASSERT_TRUE(db.Open(history_path));
+    ASSERT_TRUE(
+        db.Execute("CREATE TABLE urls (id INTEGER PRIMARY KEY, url TEXT, "
+                   "title TEXT, visit_count INTEGER, typed_count INTEGER, "
+                   "hidden INTEGER)"));
+    ASSERT_TRUE(
+        db.Execute("CREATE TABLE visits (id INTEGER PRIMARY KEY, url "
+                   "INTEGER, visit_time INTEGER, transition INTEGER)"));
+
+    sql::Transaction transaction(&db);
+    ASSERT_TRUE(transaction.Begin());
+    sql::Statement insert_url(db.GetUniqueStatement(
+        "INSERT INTO urls (id, url, title, visit_count, typed_count, hidden) "
+        "VALUES (?, ?, '', ?, 0, 0)"));
+    sql::Statement insert_visit(db.GetUniqueStatement(
+        "INSERT INTO visits (url, visit_time, transition) VALUES (?, ?, ?)"));
+    for (size_t i = 1; i <= kURLCount; i++) {
+      insert_url.Reset(true);
+      insert_url.BindInt64(0, i);
+      insert_url.BindString(
+          1, base::StringPrintf("https://example.com/%zu", i));
+      insert_url.BindInt(2, kVisitsPerURL);
+      ASSERT_TRUE(insert_url.Run());
+
+      for (int visit = 0; visit < kVisitsPerURL; visit++) {
+        insert_visit.Reset(true);
+        insert_visit.BindInt64(0, i);
+        insert_visit.BindInt64(
+            1, kFirstVisitTime + visit * base::Time::kMicrosecondsPerSecond);
+        insert_visit.BindInt64(2, ui::PAGE_TRANSITION_LINK |
+                                      ui::PAGE_TRANSITION_CHAIN_START |
+                                      ui::PAGE_TRANSITION_CHAIN_END);
+        ASSERT_TRUE(insert_visit.Run());
+      }
+    }
+    ASSERT_TRUE(transaction.Commit());
+  }
+
+  std::vector<ImporterURLRow> history;
+
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+  EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+      .Times(3)
+      .WillRepeatedly([&history](const std::vector<ImporterURLRow>& rows,
+                                 importer::VisitSource visit_source) {
+        EXPECT_LE(rows.size(), ChromeImporter::kHistoryBatchSize);
+        history.insert(history.end(), rows.begin(), rows.end());
+      });
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+
+  ASSERT_EQ(kURLCount, history.size());
+  EXPECT_EQ("https://example.com/1", history[0].url.spec());
+  for (const auto& row : history) {
+    EXPECT_EQ(kVisitsPerURL, row.visit_count);
+  }
+  // Each URL is imported with its most recent visit.
+  const double last_visit_time =
+      static_cast<double>(kFirstVisitTime -
+                          base::Time::kTimeTToMicrosecondsOffset) /
+          base::Time::kMicrosecondsPerSecond +
+      kVisitsPerURL - 1;
+  EXPECT_NEAR(last_visit_time, history[0].last_visit.ToDoubleT(), 0.001);
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 